@@ -0,0 +1,151 @@
+/**
+ * @file batchBenchmark.ino
+ * @brief Example comparing the batch animation engine with per-bar animation objects.
+ *
+ * A BL28 bar meter is split into four 7-segment sub-bar views, standing for a wall of small
+ * meters. The same animations (two looping fills, two smoothed signal followers) are run once
+ * through each view's own `animations()` controller, then through one `SBK_BarBatch` engine,
+ * and the average update cost of both is printed. The batch engine then keeps running the display.
+ *
+ * With four bars the gap is small. `extras/test/bench_batch.cpp` runs the same comparison on the
+ * host with 128 bars (64 fills, 64 followers): about 3.1 to 4.4 us per tick per-object against
+ * 1.3 to 1.7 us batch, 1.9x to 2.8x over five runs (g++ -O2, x86-64). No microcontroller
+ * figures are recorded yet: run this example on the target to get them. The batch engine alone
+ * does not need `SBK_BARDRIVE_WITH_ANIM`.
+ *
+ * Requirements:
+ *      - Supported driver with complatible library (SBK_MAX72xx or SBK_HT16K33 libraries)
+ *      - Bar meter display or leds array wired to driver
+ *      - Two live analog signals connected to A0 and A1
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+
+// ──────────────────────────────────────────────
+// SBK BarDrive Configuration Flags
+// ──────────────────────────────────────────────
+#define SBK_BARDRIVE_WITH_ANIM // Needed here for the per-object comparison only.
+
+#define BENCH_TICKS 2000 ///< Number of update ticks per benchmark run
+
+// ──────────────────────────────────────────────
+// SELECT YOUR DRIVER SETUP
+// Uncomment one of the following driver configurations
+// ──────────────────────────────────────────────
+
+/* === [A] Using MAX7219/MAX7221 via SOFTWARE SPI (any 3 digital pins) === */
+// #define DIN_PIN A4 ///< Define software SPI Data In pin
+// #define CLK_PIN A5 ///< Define software SPI Clock pin
+// #define CS_PIN A3  ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxSoft.h>
+// SBK_MAX72xxSoft driver(DIN_PIN, CLK_PIN, CS_PIN, 1); ///< Construct MAX72xx software SPI driver instance for 1 device : (DataIn pin, Clock pin, Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// typedef SBK_BarDriveView<SBK_MAX72xxSoft> Cell;
+// SBK_BarDrive<SBK_MAX72xxSoft> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+
+/* === [B] Using MAX7219/MAX7221 via HARDWARE SPI (dedicated MCU SPI pins) === */
+// #define CS_PIN A3 ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxHard.h>
+// SBK_MAX72xxHard driver(CS_PIN, 1); ///< Construct MAX72xx hardware SPI driver instance for 1 device : (Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// typedef SBK_BarDriveView<SBK_MAX72xxHard> Cell;
+// SBK_BarDrive<SBK_MAX72xxHard> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+
+/* === [C] Using HT16K33 via I2C === */
+#include <SBK_HT16K33.h>
+const uint8_t NUM_DEV = 1;       ///< Only one device : DEV0
+const uint8_t DEV0_IDX = 0;      ///< Device DEV0 index
+const uint8_t DEV0_ADD = 0x70;   ///< I2C Address (typically 0x70–0x77)
+const uint8_t DEV0_NUM_ROWS = 8; ///< 20-SOP HT16K33 with only 8 rows, 24-SOP has 12 rows, 28-SOP has 16 rows
+SBK_HT16K33 driver(NUM_DEV);
+#include <SBK_BarDrive.h>
+typedef SBK_BarDriveView<SBK_HT16K33> Cell;
+SBK_BarDrive<SBK_HT16K33> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+
+Cell cell0(bar, 0, 7);  ///< Segments 0–6
+Cell cell1(bar, 7, 7);  ///< Segments 7–13
+Cell cell2(bar, 14, 7); ///< Segments 14–20
+Cell cell3(bar, 21, 7); ///< Segments 21–27
+
+SBK_BarBatch<Cell, 4> wall; ///< Batch engine, up to 4 bars per animation type
+
+uint16_t signal0 = 0; ///< Live signal on A0
+uint16_t signal1 = 0; ///< Live signal on A1
+
+/**
+ * @brief Run BENCH_TICKS update ticks on a simulated clock.
+ * @param batch true to update the batch engine, false to update every view controller.
+ * @return Average tick cost in microseconds x 100.
+ */
+uint32_t bench(bool batch)
+{
+    uint32_t t = millis();
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < BENCH_TICKS; i++)
+    {
+        t += 5;
+        signal0 = (signal0 + 13) & 1023; // moving signals keep the followers busy
+        signal1 = (signal1 + 29) & 1023;
+        if (batch)
+            wall.update(t);
+        else
+        {
+            cell0.animations().update(t);
+            cell1.animations().update(t);
+            cell2.animations().update(t);
+            cell3.animations().update(t);
+        }
+    }
+    return (micros() - start) * 100UL / BENCH_TICKS;
+}
+
+void setup()
+{
+    Serial.begin(115200);
+
+#ifdef SBK_HT16K33_IS_DEFINED
+    // HT16K33 driver instance setup (demo uses a single device)
+    driver.setAddress(DEV0_IDX, DEV0_ADD);         // Set I2C address for device 0
+    driver.setDriverRows(DEV0_IDX, DEV0_NUM_ROWS); // Set number of active anode outputs (rows)
+#endif
+
+    driver.begin();
+
+    // Per-object: one animation controller per view, member function pointer dispatch
+    cell0.animations().animInit().fillUpIntv(20).loop();
+    cell1.animations().animInit().fillUpIntv(35).loop();
+    cell2.animations().animInit().followSignalSmooth(&signal0, 5, 0, 1023, 30, 5).loop();
+    cell3.animations().animInit().followSignalSmooth(&signal1, 5, 0, 1023, 30, 5).loop();
+    uint32_t objectCost = bench(false);
+    cell0.animations().stop();
+    cell1.animations().stop();
+    cell2.animations().stop();
+    cell3.animations().stop();
+
+    // Batch: the same animations, state grouped by animation type
+    wall.addFill(cell0, 20);
+    wall.addFill(cell1, 35);
+    wall.addFollow(cell2, &signal0);
+    wall.addFollow(cell3, &signal1);
+    uint32_t batchCost = bench(true);
+
+    Serial.print(F("Tick cost, per-object: "));
+    Serial.print(objectCost / 100.0);
+    Serial.print(F(" us, batch: "));
+    Serial.print(batchCost / 100.0);
+    Serial.println(F(" us"));
+}
+
+void loop()
+{
+    signal0 = analogRead(A0);
+    signal1 = analogRead(A1);
+    wall.update();
+    bar.show();
+}
@@ -0,0 +1,204 @@
+/**
+ * @file blockBenchmark.ino
+ * @brief Example reporting the per-tick cost of the block-based animations.
+ *
+ * Each block animation is run off-screen on a RAM frame that counts `setPixel()` calls, on a
+ * simulated clock, and the sketch prints the average number of `setPixel()` calls and the average
+ * time per animation tick. Moving blocks are updated incrementally (light the new head, clear the
+ * old tail): scrolling blocks cost two writes per block in view, a stacking head two writes per
+ * move whatever the bar length. Change BENCH_SEGS (up to 127) to compare.
+ *
+ * Reference `setPixel()` calls per tick (simulated clock, so the same on every board) at each step
+ * of the block rework: the original renderers redrawing whole blocks, the bit-lane shift engine for
+ * scrolling and mirror blocks, stacking on a stack level plus a redrawn head, then the current
+ * head/tail update of the stacking head. `make -C extras/test bench` prints the current column.
+ *
+ *     32 segments                  original  bit-lane  stack level  head/tail
+ *     scrollingUp/DownBlocks          19.06     12.70        12.70      12.70
+ *     colliding/explodingBlocks       19.14     12.76        12.76      12.76
+ *     down/upStackingBlocks           12.93     12.93         6.81       2.25
+ *     up/downUnstackingBlocks         15.66     15.66         6.47       2.31
+ *
+ *     64 segments                  original  bit-lane  stack level  head/tail
+ *     scrollingUp/DownBlocks          37.81     25.20        25.20      25.20
+ *     colliding/explodingBlocks       38.12     25.41        25.41      25.41
+ *     down/upStackingBlocks           21.81     21.81         6.94       2.15
+ *     up/downUnstackingBlocks         28.01     28.01         6.72       2.15
+ *
+ * The bar then shows every benchmarked animation in turn.
+ *
+ * Requirements:
+ *      - Supported driver with complatible library (SBK_MAX72xx or SBK_HT16K33 libraries)
+ *      - Bar meter display or leds array wired to driver
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+
+#define SBK_BARDRIVE_WITH_ANIM // Give access to preset animations and controls.
+
+#define BENCH_SEGS 64    ///< Segments of the off-screen benchmark bar
+#define BENCH_TICKS 2000 ///< Animation ticks per benchmark run
+#define BENCH_INTV 20    ///< Animation step interval in milliseconds
+#define SHOW_TIME 6000   ///< Time each animation is shown on the bar, in milliseconds
+
+// ──────────────────────────────────────────────
+// SELECT YOUR DRIVER SETUP
+// Uncomment one of the following driver configurations
+// ──────────────────────────────────────────────
+
+/* === [A] Using MAX7219/MAX7221 via SOFTWARE SPI (any 3 digital pins) === */
+// #define DIN_PIN A4 ///< Define software SPI Data In pin
+// #define CLK_PIN A5 ///< Define software SPI Clock pin
+// #define CS_PIN A3  ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxSoft.h>
+// SBK_MAX72xxSoft driver(DIN_PIN, CLK_PIN, CS_PIN, 1); ///< Construct MAX72xx software SPI driver instance for 1 device : (DataIn pin, Clock pin, Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// SBK_BarDrive<SBK_MAX72xxSoft> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/* === [B] Using MAX7219/MAX7221 via HARDWARE SPI (dedicated MCU SPI pins) === */
+// #define CS_PIN A3 ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxHard.h>
+// SBK_MAX72xxHard driver(CS_PIN, 1); ///< Construct MAX72xx hardware SPI driver instance for 1 device : (Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// SBK_BarDrive<SBK_MAX72xxHard> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/* === [C] Using HT16K33 via I2C === */
+#include <SBK_HT16K33.h>
+const uint8_t NUM_DEV = 1;       ///< Only one device : DEV0
+const uint8_t DEV0_IDX = 0;      ///< Device DEV0 index
+const uint8_t DEV0_ADD = 0x70;   ///< I2C Address (typically 0x70–0x77)
+const uint8_t DEV0_NUM_ROWS = 8; ///< 20-SOP HT16K33 with only 8 rows, 24-SOP has 12 rows, 28-SOP has 16 rows
+SBK_HT16K33 driver(NUM_DEV);
+#include <SBK_BarDrive.h>
+SBK_BarDrive<SBK_HT16K33> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/**
+ * @brief Off-screen bar counting `setPixel()` calls.
+ */
+class CountingFrame : public SBK_BarFrame<BENCH_SEGS>
+{
+public:
+    uint32_t writes = 0;
+
+    void setPixel(uint8_t segment, uint8_t state)
+    {
+        ++writes;
+        SBK_BarFrame<BENCH_SEGS>::setPixel(segment, state);
+    }
+};
+
+CountingFrame frame;                                    ///< Benchmark bar
+SBK_BarMeterAnimations<CountingFrame> benchAnim(frame); ///< Benchmark animation controller
+
+const uint8_t ANIMS_NUM = 8;
+const char *const animNames[ANIMS_NUM] = {
+    "scrollingUpBlocks", "scrollingDownBlocks", "collidingBlocks", "explodingBlocks",
+    "downStackingBlocks", "upStackingBlocks", "upUnstackingBlocks", "downUnstackingBlocks"};
+
+/**
+ * @brief Start block animation `idx` on an animation controller.
+ */
+template <typename AnimT>
+void startAnim(AnimT &anim, uint8_t idx)
+{
+    anim.stop().animInit();
+    switch (idx)
+    {
+    case 0:
+        anim.scrollingUpBlocks(BENCH_INTV, 3, 2);
+        break;
+    case 1:
+        anim.scrollingDownBlocks(BENCH_INTV, 3, 2);
+        break;
+    case 2:
+        anim.collidingBlocks(BENCH_INTV, 3, 2);
+        break;
+    case 3:
+        anim.explodingBlocks(BENCH_INTV, 3, 2);
+        break;
+    case 4:
+        anim.downStackingBlocks(BENCH_INTV, 3, 1);
+        break;
+    case 5:
+        anim.upStackingBlocks(BENCH_INTV, 3, 1);
+        break;
+    case 6:
+        anim.upUnstackingBlocks(BENCH_INTV, 3, 1);
+        break;
+    default:
+        anim.downUnstackingBlocks(BENCH_INTV, 3, 1);
+        break;
+    }
+    anim.loop();
+}
+
+/**
+ * @brief Run BENCH_TICKS animation ticks of animation `idx` and print the averages.
+ */
+void bench(uint8_t idx)
+{
+    startAnim(benchAnim, idx);
+    uint32_t t = 0;
+    benchAnim.update(t); // init tick, not measured
+    frame.writes = 0;
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < BENCH_TICKS; i++)
+    {
+        t += BENCH_INTV;
+        benchAnim.update(t);
+    }
+    uint32_t elapsed = micros() - start;
+
+    Serial.print(animNames[idx]);
+    Serial.print(F(": "));
+    Serial.print(frame.writes / (float)BENCH_TICKS);
+    Serial.print(F(" setPixel/tick, "));
+    Serial.print(elapsed / (float)BENCH_TICKS);
+    Serial.println(F(" us/tick"));
+}
+
+uint8_t shownAnim = 0;   ///< Animation shown on the bar
+uint32_t lastSwitch = 0; ///< Last animation switch time
+
+void setup()
+{
+    Serial.begin(115200);
+
+#ifdef SBK_HT16K33_IS_DEFINED
+    // HT16K33 driver instance setup (demo uses a single device)
+    driver.setAddress(DEV0_IDX, DEV0_ADD);         // Set I2C address for device 0
+    driver.setDriverRows(DEV0_IDX, DEV0_NUM_ROWS); // Set number of active anode outputs (rows)
+#endif
+
+    driver.begin();
+
+    benchAnim.setSegsNum(BENCH_SEGS);
+    Serial.print(F("Block animations, "));
+    Serial.print(BENCH_SEGS);
+    Serial.println(F(" segments:"));
+    for (uint8_t i = 0; i < ANIMS_NUM; i++)
+        bench(i);
+    benchAnim.stop();
+
+    startAnim(bar.animations(), shownAnim);
+    lastSwitch = millis();
+}
+
+void loop()
+{
+    if (millis() - lastSwitch >= SHOW_TIME)
+    {
+        lastSwitch = millis();
+        shownAnim = (shownAnim + 1) % ANIMS_NUM;
+        bar.clear();
+        startAnim(bar.animations(), shownAnim);
+    }
+    bar.animations().update();
+    bar.show();
+}
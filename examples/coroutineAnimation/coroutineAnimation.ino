@@ -0,0 +1,159 @@
+/**
+ * @file coroutineAnimation.ino
+ * @brief Example showing a custom animation written as a C++20 coroutine, and its update cost.
+ *
+ * The animation is a plain linear script: sweep the bar up, wait for the analog signal to
+ * cross a level, blink the bar three times, then empty it. `co_await SBK_BarCoro::delay()` and
+ * `co_await SBK_BarCoro::untilLevel()` suspend the script; `animations().update()` resumes it.
+ * Coroutine frames come from a fixed static arena, no heap is used.
+ *
+ * At startup, the sketch prints the average `update()` cost of the coroutine animation and of
+ * a built-in (member function) animation, measured over the same number of calls.
+ *
+ * Requirements:
+ *      - C++20 compiler with coroutine support (e.g., ESP32 with build flag -std=gnu++2a)
+ *      - Supported driver with complatible library (SBK_MAX72xx or SBK_HT16K33 libraries)
+ *      - Bar meter display or leds array wired to driver
+ *      - A live analog signal connected to A0
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+
+#define SBK_BARDRIVE_WITH_ANIM       // Give access to preset animations and controls.
+#define SBK_BARDRIVE_WITH_COROUTINES // Give access to coroutine animations (C++20).
+
+#define ANALOG_PIN A0        ///< Analog input pin
+#define TRIGGER_LEVEL 600    ///< Signal level ending the wait
+#define BENCH_UPDATES 10000  ///< Number of update() calls per benchmark run
+uint16_t signalLevel = 0;    ///< Last analog reading, watched by the coroutine
+
+// ──────────────────────────────────────────────
+// SELECT YOUR DRIVER SETUP
+// Uncomment one of the following driver configurations
+// ──────────────────────────────────────────────
+
+/* === [A] Using MAX7219/MAX7221 via SOFTWARE SPI (any 3 digital pins) === */
+// #define DIN_PIN A4 ///< Define software SPI Data In pin
+// #define CLK_PIN A5 ///< Define software SPI Clock pin
+// #define CS_PIN A3  ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxSoft.h>
+// SBK_MAX72xxSoft driver(DIN_PIN, CLK_PIN, CS_PIN, 1); ///< Construct MAX72xx software SPI driver instance for 1 device : (DataIn pin, Clock pin, Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// typedef SBK_MAX72xxSoft Driver;
+// SBK_BarDrive<Driver> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/* === [B] Using MAX7219/MAX7221 via HARDWARE SPI (dedicated MCU SPI pins) === */
+// #define CS_PIN A3 ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxHard.h>
+// SBK_MAX72xxHard driver(CS_PIN, 1); ///< Construct MAX72xx hardware SPI driver instance for 1 device : (Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// typedef SBK_MAX72xxHard Driver;
+// SBK_BarDrive<Driver> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/* === [C] Using HT16K33 via I2C === */
+#include <SBK_HT16K33.h>
+const uint8_t NUM_DEV = 1;       ///< Only one device : DEV0
+const uint8_t DEV0_IDX = 0;      ///< Device DEV0 index
+const uint8_t DEV0_ADD = 0x70;   ///< I2C Address (typically 0x70–0x77)
+const uint8_t DEV0_NUM_ROWS = 8; ///< 20-SOP HT16K33 with only 8 rows, 24-SOP has 12 rows, 28-SOP has 16 rows
+SBK_HT16K33 driver(NUM_DEV);
+#include <SBK_BarDrive.h>
+typedef SBK_HT16K33 Driver;
+SBK_BarDrive<Driver> bar(&driver, 0, MatrixPreset::BL28_3005SK); ///< Construct using matrix type bar meter preset (auto-mapped layout) : (driver, device index, MatrixPreset type)
+
+/**
+ * @brief Coroutine animation: each `co_await` hands control back to loop().
+ */
+SBK_BarAnimTask sweepAndBlink(SBK_BarMeter<Driver> &b)
+{
+    using SBK_BarCoro::delay; // SBK_BarCoro::delay, not Arduino delay()
+
+    for (uint8_t i = 0; i < b.getSegsNum(); i++)
+    {
+        b.setPixel(i, true);
+        co_await delay(20);
+    }
+
+    co_await SBK_BarCoro::untilLevel(signalLevel, TRIGGER_LEVEL);
+
+    for (uint8_t n = 0; n < 3; n++)
+    {
+        b.clear();
+        co_await delay(150);
+        for (uint8_t i = 0; i < b.getSegsNum(); i++)
+            b.setPixel(i, true);
+        co_await delay(150);
+    }
+
+    for (uint8_t i = b.getSegsNum(); i > 0; i--)
+    {
+        b.setPixel(i - 1, false);
+        co_await delay(10);
+    }
+    co_await delay(500);
+}
+
+/**
+ * @brief Average update() cost, in microseconds x 100, on a simulated clock.
+ */
+uint32_t benchUpdates()
+{
+    uint32_t t = 0;
+    uint32_t start = micros();
+    for (uint16_t i = 0; i < BENCH_UPDATES; i++)
+    {
+        bar.animations().update(t);
+        t += 10;
+    }
+    return (micros() - start) * 100UL / BENCH_UPDATES;
+}
+
+#if !defined(SBK_BARDRIVE_HAS_COROUTINES)
+#error "This example needs a C++20 compiler with coroutine support."
+#endif
+
+void setup()
+{
+    Serial.begin(115200);
+
+#ifdef SBK_HT16K33_IS_DEFINED
+    // HT16K33 driver instance setup (demo uses a single device)
+    driver.setAddress(DEV0_IDX, DEV0_ADD);         // Set I2C address for device 0
+    driver.setDriverRows(DEV0_IDX, DEV0_NUM_ROWS); // Set number of active anode outputs (rows)
+#endif
+
+    driver.begin();
+    bar.setDirection(BarDirection::FORWARD); // Optional: use REVERSE for opposite orientation
+
+    // Resume cost: coroutine vs member function pointer dispatch (no show(), renderer cost only)
+    signalLevel = 1023; // never block on the level wait during the benchmark
+    bar.animations().animInit().playCoroutine(sweepAndBlink).loop();
+    uint32_t coroCost = benchUpdates();
+    bar.animations().stop().animInit().fillUpIntv(20).loop();
+    uint32_t builtInCost = benchUpdates();
+    Serial.print(F("update() coroutine: "));
+    Serial.print(coroCost / 100.0);
+    Serial.print(F(" us, built-in: "));
+    Serial.print(builtInCost / 100.0);
+    Serial.println(F(" us"));
+
+    bar.animations().stop();
+    bar.clear();
+    bar.animations().animInit().playCoroutine(sweepAndBlink).loop();
+}
+
+/**
+ * @brief Main loop: sample the signal, resume the animation, push it to the display.
+ */
+void loop()
+{
+    signalLevel = analogRead(ANALOG_PIN);
+    bar.animations().update();
+    bar.show();
+}
@@ -0,0 +1,97 @@
+/**
+ * @file subBarViews.ino
+ * @brief Example showing how to split one physical bar meter into independent sub-bar views.
+ *
+ * A single BL28 28-segment bar meter is shown as two independent 14-segment meters
+ * (left/right channels). Each view has its own animation controller, while both share
+ * the parent bar mapping and driver buffer, so a single show() commits both halves.
+ *
+ * Requirements:
+ *      - Supported driver with complatible library (SBK_MAX72xx or SBK_HT16K33 libraries)
+ *      - Bar meter display or leds array wired to driver
+ *      - Two live analog signals connected to A0 and A1
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+
+// ──────────────────────────────────────────────
+// SBK BarDrive Configuration Flags
+// ──────────────────────────────────────────────
+#define SBK_BARDRIVE_WITH_ANIM // Give access to preset animations and controls.
+
+// ──────────────────────────────────────────────
+// SELECT YOUR DRIVER SETUP
+// Uncomment one of the following driver configurations
+// ──────────────────────────────────────────────
+
+/* === [A] Using MAX7219/MAX7221 via SOFTWARE SPI (any 3 digital pins) === */
+// #define DIN_PIN A4 ///< Define software SPI Data In pin
+// #define CLK_PIN A5 ///< Define software SPI Clock pin
+// #define CS_PIN A3  ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxSoft.h>
+// SBK_MAX72xxSoft driver(DIN_PIN, CLK_PIN, CS_PIN, 1); ///< Construct MAX72xx software SPI driver instance for 1 device : (DataIn pin, Clock pin, Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// SBK_BarDrive<SBK_MAX72xxSoft> bar(&driver, 0, MatrixPreset::BL28_3005SK);                   ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+// SBK_BarDriveView<SBK_MAX72xxSoft> leftCh(bar, 0, 14, BarDirection::REVERSE);                ///< Segments 0–13, filling from the center down : (parent, first segment, segments count, BarDirection)
+// SBK_BarDriveView<SBK_MAX72xxSoft> rightCh(bar, 14, 14);                                     ///< Segments 14–27, filling from the center up : (parent, first segment, segments count)
+
+/* === [B] Using MAX7219/MAX7221 via HARDWARE SPI (dedicated MCU SPI pins) === */
+// #define CS_PIN A3 ///< Define SPI Chip Select pin
+// #include <SBK_MAX72xxHard.h>
+// SBK_MAX72xxHard driver(CS_PIN, 1); ///< Construct MAX72xx hardware SPI driver instance for 1 device : (Chip Select pin, devices number)
+// #include <SBK_BarDrive.h>
+// SBK_BarDrive<SBK_MAX72xxHard> bar(&driver, 0, MatrixPreset::BL28_3005SK);                   ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+// SBK_BarDriveView<SBK_MAX72xxHard> leftCh(bar, 0, 14, BarDirection::REVERSE);                ///< Segments 0–13, filling from the center down : (parent, first segment, segments count, BarDirection)
+// SBK_BarDriveView<SBK_MAX72xxHard> rightCh(bar, 14, 14);                                     ///< Segments 14–27, filling from the center up : (parent, first segment, segments count)
+
+/* === [C] Using HT16K33 via I2C === */
+#include <SBK_HT16K33.h>
+const uint8_t NUM_DEV = 1;       ///< Only one device : DEV0
+const uint8_t DEV0_IDX = 0;      ///< Device DEV0 index
+const uint8_t DEV0_ADD = 0x70;   ///< I2C Address (typically 0x70–0x77)
+const uint8_t DEV0_NUM_ROWS = 8; ///< 20-SOP HT16K33 with only 8 rows, 24-SOP has 12 rows, 28-SOP has 16 rows
+SBK_HT16K33 driver(NUM_DEV);
+#include <SBK_BarDrive.h>
+SBK_BarDrive<SBK_HT16K33> bar(&driver, 0, MatrixPreset::BL28_3005SK);    ///< Parent bar meter using matrix preset : (driver, device index, MatrixPreset type)
+SBK_BarDriveView<SBK_HT16K33> leftCh(bar, 0, 14, BarDirection::REVERSE); ///< Segments 0–13, filling from the center down : (parent, first segment, segments count, BarDirection)
+SBK_BarDriveView<SBK_HT16K33> rightCh(bar, 14, 14);                      ///< Segments 14–27, filling from the center up : (parent, first segment, segments count)
+
+#define LEFT_PIN A0  ///< Left channel analog input pin
+#define RIGHT_PIN A1 ///< Right channel analog input pin
+
+uint16_t leftSignal = 0;  ///< Left channel live signal
+uint16_t rightSignal = 0; ///< Right channel live signal
+
+void setup()
+{
+
+#ifdef SBK_HT16K33_IS_DEFINED
+    // HT16K33 driver instance setup (demo uses a single device)
+    driver.setAddress(DEV0_IDX, DEV0_ADD);         // Set I2C address for device 0
+    driver.setDriverRows(DEV0_IDX, DEV0_NUM_ROWS); // Set number of active anode outputs (rows)
+#endif
+
+    driver.begin();
+    driver.setBrightness(0, 10);
+
+    // Each view runs its own animation over its own half of the bar
+    leftCh.animations().animInit().followSignalSmooth(&leftSignal, 50);
+    rightCh.animations().animInit().followSignalWithPointer(&rightSignal, 50);
+}
+
+void loop()
+{
+    leftSignal = analogRead(LEFT_PIN);
+    rightSignal = analogRead(RIGHT_PIN);
+
+    leftCh.animations().update();
+    rightCh.animations().update();
+
+    bar.show(); // A single show() commits both halves
+}
@@ -0,0 +1,110 @@
+/**
+ * @file MockDriver.h
+ * @brief In-memory LED driver and check helpers for the host tests.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#define SBK_MAX72xx_IS_DEFINED // Stands in for a driver library: silences the missing driver note
+
+/**
+ * @brief Driver keeping 8x8 LEDs per device in RAM and counting the calls it receives.
+ */
+struct MockDriver
+{
+    static const uint8_t MAX_DEVS = 8;
+
+    uint8_t devs;
+    uint8_t rows[MAX_DEVS][8];
+    uint8_t brightness[MAX_DEVS];
+    uint32_t setLeds = 0;        ///< setLed() calls
+    mutable uint32_t getLeds = 0; ///< getLed() calls
+    uint32_t shows = 0;
+
+    explicit MockDriver(uint8_t devsNum = 1) : devs(devsNum)
+    {
+        memset(rows, 0, sizeof(rows));
+        memset(brightness, 15, sizeof(brightness));
+    }
+
+    void begin() {}
+    uint8_t devsNum() const { return devs; }
+    uint8_t maxRows(uint8_t) const { return 8; }
+    uint8_t maxColumns() const { return 8; }
+    uint8_t maxSegments(uint8_t) const { return 64; }
+
+    void setLed(uint8_t devIdx, uint8_t row, uint8_t column, bool state)
+    {
+        ++setLeds;
+        if (state)
+            rows[devIdx][row] |= (uint8_t)(1 << column);
+        else
+            rows[devIdx][row] &= (uint8_t)~(1 << column);
+    }
+
+    bool getLed(uint8_t devIdx, uint8_t row, uint8_t column) const
+    {
+        ++getLeds;
+        return (rows[devIdx][row] >> column) & 1;
+    }
+
+    void setBrightness(uint8_t devIdx, uint8_t level) { brightness[devIdx] = level; }
+
+    void show()
+    {
+        ++shows;
+        litAtShow = 0;
+        for (uint8_t d = 0; d < devs; ++d)
+            for (uint8_t r = 0; r < 8; ++r)
+                litAtShow += __builtin_popcount(rows[d][r]);
+    }
+
+    uint16_t litAtShow = 0; ///< LEDs lit at the last show()
+};
+
+/**
+ * @brief MockDriver with the optional driver API: power-down, hardware blink, brightness read-back.
+ */
+struct MockPowerDriver : MockDriver
+{
+    uint8_t blinkRate[MAX_DEVS];
+    bool down[MAX_DEVS];
+
+    explicit MockPowerDriver(uint8_t devsNum = 1) : MockDriver(devsNum)
+    {
+        memset(blinkRate, 0, sizeof(blinkRate));
+        memset(down, 0, sizeof(down));
+    }
+
+    void setBlinkRate(uint8_t devIdx, uint8_t rate) { blinkRate[devIdx] = rate; }
+    void shutdown(uint8_t devIdx, bool status) { down[devIdx] = status; }
+    uint8_t getBrightness(uint8_t devIdx) const { return brightness[devIdx]; }
+};
+
+static int hostFailures = 0; ///< Failed checks of the test
+
+/** @brief Record a failed check, with its location, without stopping the test. */
+#define HOST_CHECK(cond)                                                              \
+    do                                                                                \
+    {                                                                                 \
+        if (!(cond))                                                                  \
+        {                                                                             \
+            fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            ++hostFailures;                                                           \
+        }                                                                             \
+    } while (0)
+
+/** @brief Print the test verdict. @return Process exit code. */
+inline int hostReport(const char *name)
+{
+    printf("%s: %s\n", name, hostFailures ? "FAILED" : "ok");
+    return hostFailures ? 1 : 0;
+}
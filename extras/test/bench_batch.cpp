@@ -0,0 +1,94 @@
+/**
+ * @file bench_batch.cpp
+ * @brief Host benchmark of the batch animation engine against per-bar animation objects.
+ *
+ * 128 off-screen 28-segment bars, 64 running a looping fill and 64 following a moving signal
+ * with smoothing, are updated on a simulated 5 ms clock: once through one
+ * `SBK_BarMeterAnimations` controller per bar, once through a single `SBK_BarBatch`. Bars are
+ * `SBK_BarFrame`s so only the animation cost is measured, not a driver. The best of several
+ * runs is printed, in microseconds per tick for all 128 bars.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+static const uint8_t BARS = 128;
+static const uint8_t SEGS = 28;
+static const uint32_t TICKS = 20000;
+static const uint8_t RUNS = 15;
+
+typedef SBK_BarFrame<SEGS> Frame;
+typedef SBK_BarMeterAnimations<Frame> Anim;
+
+static Frame frames[BARS];
+static Anim *anims[BARS];
+static uint16_t signals[BARS / 2];
+static SBK_BarBatch<Frame, BARS / 2> wall;
+
+static void moveSignals(uint32_t tick)
+{
+    for (uint8_t i = 0; i < BARS / 2; ++i)
+        signals[i] = (uint16_t)((tick * (13 + i)) & 1023);
+}
+
+/** @brief Average tick cost in microseconds, best of RUNS. */
+template <typename F>
+static double bench(F step)
+{
+    double best = 1e9;
+    for (uint8_t r = 0; r < RUNS; ++r)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (uint32_t t = 0; t < TICKS; ++t)
+            step(t);
+        const double us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+        best = min(best, us / TICKS);
+    }
+    return best;
+}
+
+int main()
+{
+    for (uint8_t i = 0; i < BARS; ++i)
+    {
+        frames[i].setSegsNum(SEGS);
+        anims[i] = new Anim(frames[i]);
+        anims[i]->setSegsNum(SEGS);
+    }
+
+    // Per-object: one controller per bar, member function pointer dispatch
+    for (uint8_t i = 0; i < BARS / 2; ++i)
+    {
+        anims[i]->fillUpIntv(20 + i % 16).loop();
+        anims[BARS / 2 + i]->followSignalSmooth(&signals[i], 5, 0, 1023, 30, 5).loop();
+    }
+    const double object = bench([](uint32_t t) {
+        moveSignals(t);
+        for (uint8_t i = 0; i < BARS; ++i)
+            anims[i]->update(t * 5);
+    });
+    for (uint8_t i = 0; i < BARS; ++i)
+        anims[i]->stop();
+
+    // Batch: the same animations, state grouped by animation type
+    for (uint8_t i = 0; i < BARS / 2; ++i)
+    {
+        wall.addFill(frames[i], 20 + i % 16);
+        wall.addFollow(frames[BARS / 2 + i], &signals[i], 0, 1023, 30, 5);
+    }
+    const double batch = bench([](uint32_t t) {
+        moveSignals(t);
+        wall.update(t * 5);
+    });
+
+    printf("bench_batch: %u bars (%u fill, %u follow), per-object %.2f us/tick, batch %.2f us/tick, %.1fx\n",
+           BARS, BARS / 2, BARS / 2, object, batch, object / batch);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/**
+ * @file bench_blocks.cpp
+ * @brief Host run of the `blockBenchmark` example: `setPixel()` calls per tick of every block animation.
+ *
+ * Same animations, parameters and simulated clock as the example, at 32 and 64 segments, on a
+ * bar meter counting its `setPixel()` calls. The counts do not depend on the board.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+static const uint16_t BENCH_TICKS = 2000;
+static const uint16_t BENCH_INTV = 20;
+
+/** @brief Bar meter counting the `setPixel()` calls of the animations. */
+struct CountingMeter : SBK_BarMeter<MockDriver>
+{
+    uint32_t writes = 0;
+
+    CountingMeter(MockDriver *driver, uint8_t segsNum) : SBK_BarMeter<MockDriver>(driver, 0, segsNum) {}
+
+    void setPixel(uint8_t segment, uint8_t state)
+    {
+        ++writes;
+        SBK_BarMeter<MockDriver>::setPixel(segment, state);
+    }
+};
+
+static const char *const NAMES[] = {"scrollingUpBlocks", "scrollingDownBlocks", "collidingBlocks",
+                                    "explodingBlocks", "downStackingBlocks", "upStackingBlocks",
+                                    "upUnstackingBlocks", "downUnstackingBlocks"};
+
+void run(uint8_t segs)
+{
+    MockDriver driver(1);
+    CountingMeter meter(&driver, segs);
+    SBK_BarMeterAnimations<CountingMeter> anim(meter);
+    anim.setSegsNum(segs);
+
+    printf("bench_blocks: %u segments, setPixel() calls per tick\n", segs);
+    for (uint8_t i = 0; i < 8; ++i)
+    {
+        anim.stop().animInit();
+        switch (i)
+        {
+        case 0: anim.scrollingUpBlocks(BENCH_INTV, 3, 2); break;
+        case 1: anim.scrollingDownBlocks(BENCH_INTV, 3, 2); break;
+        case 2: anim.collidingBlocks(BENCH_INTV, 3, 2); break;
+        case 3: anim.explodingBlocks(BENCH_INTV, 3, 2); break;
+        case 4: anim.downStackingBlocks(BENCH_INTV, 3, 1); break;
+        case 5: anim.upStackingBlocks(BENCH_INTV, 3, 1); break;
+        case 6: anim.upUnstackingBlocks(BENCH_INTV, 3, 1); break;
+        default: anim.downUnstackingBlocks(BENCH_INTV, 3, 1); break;
+        }
+        anim.loop();
+        uint32_t t = 0;
+        anim.update(t); // first tick sets the animation up
+        meter.writes = 0;
+        for (uint16_t k = 0; k < BENCH_TICKS; ++k)
+        {
+            t += BENCH_INTV;
+            hostMillis = t;
+            anim.update(t);
+        }
+        printf("    %-22s %6.2f\n", NAMES[i], meter.writes / (double)BENCH_TICKS);
+    }
+}
+
+int main()
+{
+    run(32);
+    run(64);
+    return 0;
+}
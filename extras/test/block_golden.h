@@ -0,0 +1,58 @@
+// Golden frame hashes for test_block_golden.cpp, printed by `test_block_golden --record`.
+// Recorded from the Block array scrolling/mirror renderers, before the bit-lane engine.
+
+#pragma once
+
+#include <stdint.h>
+
+static const uint32_t BLOCK_GOLDEN[300] = {
+    0x61D7BAED, 0xD6161BBB, 0xB7F06DB9, 0x9AD46AE8, 0xE880D710, 0x21243CA3,
+    0xD9878187, 0x72959ED4, 0x0A15D601, 0x40526514, 0xAE6192D0, 0xEA381E4B,
+    0xBFD24257, 0xE77AD42B, 0x1D41C22D, 0xD30F596D, 0x2BD8C29D, 0x8C7BEBFC,
+    0x3A31723E, 0x44066719, 0x3077D959, 0x093BED59, 0x7997EDB4, 0x04E79CB1,
+    0xC45D6228, 0xBDF7CBFB, 0x5BE60AF0, 0xC9732386, 0x4FDD9E74, 0x4251634D,
+    0xFA13B9BE, 0x1DFF78F5, 0xD8ED83D8, 0x793F0DDA, 0x11541D1A, 0xD78AEEB5,
+    0xF30B4355, 0x40A874B1, 0xFC86C5B1, 0x05D843D5, 0x1B5F9F0C, 0xDE518164,
+    0x3AB5AFB7, 0xBB6F04CA, 0xCB04EDF9, 0xB2C5A8CD, 0x9E9BB3CC, 0xB65E5DD2,
+    0x8A30C3F7, 0x35173B63, 0x374A61E5, 0x7265175E, 0xA384EF5E, 0x36BF7915,
+    0xD43B8F59, 0xCCDBC1C2, 0xB25A4F1D, 0x35581BEE, 0x0B4C3A1A, 0x055B25BB,
+    0x93F5F788, 0xDD01AC62, 0x002158C6, 0x523CACC7, 0x83B734B4, 0x00410BE5,
+    0x89D13C02, 0x182883BD, 0xBFEEBE16, 0xFE0325ED, 0xCE85D71C, 0x7407E34A,
+    0xBF4A8574, 0xAB1B0EA2, 0x1D387F46, 0xD6250432, 0x7A30611D, 0xD255F933,
+    0xA65F8D4B, 0xF874E260, 0x9A126DC8, 0x41455CAB, 0xE4F499EF, 0x098A88F8,
+    0xC946FE65, 0x01DFC9B6, 0xD1569962, 0x5E1C8159, 0xCD045621, 0x33FC5596,
+    0x5738FBD2, 0xB77F087F, 0x889EB864, 0x9FDD1CDF, 0xF9188199, 0x11847541,
+    0xCA52013F, 0x9DD4D35D, 0xC577BC15, 0xCB9905D2, 0xAE4C4597, 0xED5D9D68,
+    0xF02CA066, 0x12FB7D23, 0x828B62E6, 0xB5C5EEB7, 0x86397A84, 0x587D4344,
+    0xDBE498AF, 0xD75FFC2D, 0xD22F410F, 0x9C2CFA9D, 0x213DC408, 0xD88AA884,
+    0xB5E94F0B, 0x41CC0896, 0x40B7DA45, 0xB11CE8F6, 0x6E60CEE5, 0x8C014B06,
+    0x21073A7F, 0x34FE1A2E, 0x5D3DCE4E, 0xCD173C92, 0xC1CFA380, 0x1B72F790,
+    0x2347B53B, 0x6BE5CE65, 0xE3E1EBB4, 0x2DE146AC, 0xF08C1552, 0x56F566F5,
+    0x0085DCB7, 0x8ECF1F3E, 0xBD972F3A, 0x43B2A468, 0xF7FEB024, 0x7A598C01,
+    0x74ABE8A5, 0xFC517DA5, 0xF2F72A1E, 0xBEBC3E75, 0xD2C70BF7, 0x4C77C155,
+    0x69648A85, 0x0A1BF84D, 0xE8EBE8E4, 0xD46EC531, 0xDD3B428F, 0x7031611B,
+    0xC4A1CD3B, 0x779D7505, 0xD1374604, 0x01777DA1, 0xD43E0979, 0x724D9BBE,
+    0x31503947, 0x50CEBE97, 0xD4D4F831, 0x58D94A89, 0xF9C7709A, 0xA7C30774,
+    0x545C8B40, 0x04B366B1, 0xA4FCFB95, 0xBB5F9B29, 0x029C9824, 0x6D9D9485,
+    0x5600CEB2, 0x89216538, 0x379A24D7, 0x478F0DD4, 0x5E0396AD, 0xEEE24B69,
+    0x699B18BD, 0xB62D90E0, 0x5A065D4E, 0xAAF5B764, 0x7BFC21A3, 0x26255F8C,
+    0x2AC5A1F6, 0xD9E09F09, 0xC7E09097, 0x5308E2C7, 0x647AE1A9, 0xE2AC75B8,
+    0xE8E233E5, 0x1A18D193, 0x4572CF8B, 0x8BFBB126, 0xCD48CD50, 0x17421280,
+    0xDE796DDF, 0xCC808F2D, 0x7145BA85, 0x8688E731, 0xF2056407, 0x6FA8D867,
+    0x6C41744B, 0x9C274E7C, 0x3226CEA6, 0xCBBE81AE, 0xB9873DCE, 0x1E9E4B5F,
+    0x9618ACE6, 0xC273BA4E, 0x21130C09, 0x16591AC4, 0x59C35005, 0xF3F50130,
+    0xFEBA426A, 0x07476E76, 0x527084CA, 0x1132A17C, 0xAFCC9D8E, 0x9EE0ECB3,
+    0xB2CBC3A5, 0x583BB363, 0x1E479C68, 0xAF912B96, 0xA4454105, 0xD53F1E7A,
+    0x177227BB, 0x6F156980, 0xDDBB3BB7, 0xFD551D62, 0x89AE3C4E, 0xF2DC7929,
+    0x19A9B250, 0x0951B787, 0x4E53EBFA, 0x9020AACB, 0xC9907940, 0x703EE6B3,
+    0x52289F40, 0xB4A7F417, 0x5FED8F2D, 0xC7BCDE04, 0x72D4EDF7, 0x5E2A09F9,
+    0xDC9CBCB5, 0x6BAF4A42, 0xBDF2E854, 0x76D96746, 0xD354E640, 0x1FBCD73B,
+    0x45C1D2C7, 0xA7444DCC, 0xEEC43B5E, 0x33AAE80B, 0x0B119B2C, 0x849300F8,
+    0xC73C71F2, 0x197ADD4B, 0x56F7DD10, 0xF4E3F42F, 0x354A4E46, 0x56979BB5,
+    0xB2C8705C, 0xF5BC6E6A, 0xC7901708, 0xFDF4BCD6, 0x348A33D7, 0xC5209BFB,
+    0x7388F738, 0xA14ED03E, 0xDBFAF4C8, 0xDF11ACAA, 0xC10CB950, 0x527DAD38,
+    0x5BEC6475, 0x0BE7A56F, 0x6687A5A1, 0xDD96DF34, 0x6E3F1ACF, 0x18451AB1,
+    0xA764E663, 0x489A800E, 0x85155E51, 0x8E741130, 0xD648EE5D, 0x36AA3012,
+    0x6FF3521E, 0xAD10FB21, 0xB9505BCE, 0xE7C8E9EA, 0xFD82623B, 0xD6E05139,
+    0x830603B7, 0x3E669033, 0x046F35F6, 0x7F451FF2, 0x26013134, 0x3AB60F01,
+    0xFBE68361, 0x32F5F905, 0x02BC398D, 0xF77F2327, 0x42EAC997, 0x30CC9BC3};
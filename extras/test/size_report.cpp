@@ -0,0 +1,66 @@
+/**
+ * @file size_report.cpp
+ * @brief Code size of two driver types through `SBK_BarDriverRef` against direct instantiation.
+ *
+ * Two bars on two different driver types run nine animations. Built once with each driver type
+ * instantiating the library (`SIZE_REPORT_REF=0`) and once with both behind `SBK_BarDriverRef`
+ * (`SIZE_REPORT_REF=1`); `make -C extras/test size` prints the text size of both.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+/** @brief A second driver type, for a second instantiation of the library. */
+struct OtherDriver : MockDriver
+{
+    explicit OtherDriver(uint8_t devsNum = 1) : MockDriver(devsNum) {}
+};
+
+MockDriver driver1(1);
+OtherDriver driver2(1);
+
+#if SIZE_REPORT_REF
+SBK_BarDriverRef ref1(&driver1), ref2(&driver2);
+SBK_BarDrive<SBK_BarDriverRef> bar1(&ref1, 0, MatrixPreset::BL28_3005SK);
+SBK_BarDrive<SBK_BarDriverRef> bar2(&ref2, 0, MatrixPreset::BL28_3005SK);
+#else
+SBK_BarDrive<MockDriver> bar1(&driver1, 0, MatrixPreset::BL28_3005SK);
+SBK_BarDrive<OtherDriver> bar2(&driver2, 0, MatrixPreset::BL28_3005SK);
+#endif
+
+volatile int selected; // unknown at compile time: every animation is kept
+uint16_t level;
+
+template <typename BarT>
+void drive(BarT &bar)
+{
+    auto &anim = bar.animations();
+    switch (selected)
+    {
+    case 0: anim.fillUpIntv(10); break;
+    case 1: anim.bounceFillUpIntv(10, 10); break;
+    case 2: anim.explodingBlocks(10); break;
+    case 3: anim.followSignalSmooth(&level); break;
+    case 4: anim.randomFill(10); break;
+    case 5: anim.beatPulse(120); break;
+    case 6: anim.scrollingUpBlocks(10); break;
+    case 7: anim.bounceFillFromCenterIntv(10); break;
+    default: anim.upStackingBlocks(10); break;
+    }
+    anim.update();
+    bar.show();
+}
+
+int main()
+{
+    drive(bar1);
+    drive(bar2);
+    return 0;
+}
@@ -0,0 +1,73 @@
+/**
+ * @file Arduino.h
+ * @brief Minimal Arduino core stand-in for the host tests.
+ *
+ * Provides the few core functions and macros the library uses. The clock is simulated:
+ * `millis()` returns `hostMillis`, which the tests advance themselves.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#pragma once
+
+// Standard headers first: the Arduino min/max macros below would break them
+#include <atomic>
+#include <chrono>
+#include <new>
+#include <thread>
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PROGMEM
+#define F(x) (x)
+#define HEX 16
+#define DEC 10
+#define pgm_read_byte(p) (*(const uint8_t *)(p))
+#define pgm_read_word(p) (*(const uint16_t *)(p))
+#define memcpy_P memcpy
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+#define noInterrupts()
+#define interrupts()
+
+typedef bool boolean;
+
+static uint32_t hostMillis = 0; ///< Simulated clock, in milliseconds
+
+inline uint32_t millis() { return hostMillis; }
+inline uint32_t micros() { return hostMillis * 1000; }
+inline long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+inline long random(long lo, long hi) { return lo + rand() % (hi - lo); }
+inline long random(long hi) { return rand() % hi; }
+inline uint16_t analogRead(uint8_t) { return 0; }
+
+/** @brief Stream printing to stdout once `begin()` was called. */
+struct Stream
+{
+    bool out = false;
+    void begin(long) { out = true; }
+    void print(const char *s) { if (out) printf("%s", s); }
+    void print(char c) { if (out) printf("%c", c); }
+    void print(int v, int base = DEC) { print((long)v, base); }
+    void print(unsigned v, int base = DEC) { print((unsigned long)v, base); }
+    void print(long v, int base = DEC) { if (out) printf(base == HEX ? "%lX" : "%ld", v); }
+    void print(unsigned long v, int base = DEC) { if (out) printf(base == HEX ? "%lX" : "%lu", v); }
+    void print(double v) { if (out) printf("%.2f", v); }
+    template <typename T>
+    void println(T v) { print(v); println(); }
+    void println() { if (out) printf("\n"); }
+};
+
+static Stream Serial;
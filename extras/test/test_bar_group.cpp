@@ -0,0 +1,186 @@
+/**
+ * @file test_bar_group.cpp
+ * @brief Bar group (SBK_BarGroup.h): flush skipping, idle power-down, wake-up, blink and power budget.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+typedef SBK_BarDrive<MockPowerDriver> Bar;
+typedef SBK_BarGroup<MockPowerDriver> Group;
+
+void fill(Bar &bar, uint8_t lit)
+{
+    for (uint8_t i = 0; i < bar.getSegsNum(); ++i)
+        bar.setPixel(i, i < lit);
+}
+
+void testIdlePowerDown()
+{
+    MockPowerDriver driver(1);
+    Bar bar(&driver, 0, MatrixPreset::BL28_3005SK);
+    Group group(&driver);
+    group.addBar(bar);
+    group.setIdleTimeout(1000);
+    fill(bar, 10);
+
+    hostMillis = 0;
+    HOST_CHECK(group.show());  // first flush
+    HOST_CHECK(!group.show()); // nothing changed
+    for (hostMillis = 10; hostMillis < 1000; hostMillis += 10)
+        group.show();
+    HOST_CHECK(!group.isPoweredDown(0));
+    hostMillis = 1000;
+    group.show();
+    HOST_CHECK(group.isPoweredDown(0) && driver.down[0]);
+    HOST_CHECK(group.getStats().powerDowns == 1);
+
+    // A change wakes the device up and is flushed
+    const uint32_t shows = driver.shows;
+    hostMillis = 1500;
+    bar.setPixel(20, true);
+    HOST_CHECK(group.show());
+    HOST_CHECK(!group.isPoweredDown(0) && !driver.down[0]);
+    HOST_CHECK(driver.shows == shows + 1 && driver.litAtShow == 11);
+    HOST_CHECK(group.getStats().poweredDownMs == 500);
+}
+
+void testDarkPowerDown()
+{
+    MockPowerDriver driver(1);
+    Bar bar(&driver, 0, MatrixPreset::BL28_3005SK);
+    Group group(&driver);
+    group.addBar(bar);
+
+    // Opt-in: a dark device stays powered by default
+    hostMillis = 0;
+    group.show();
+    HOST_CHECK(!group.isPoweredDown(0));
+
+    group.setPowerDownWhenDark(true);
+    group.show();
+    HOST_CHECK(group.isPoweredDown(0));
+    bar.setPixel(0, true);
+    group.show();
+    HOST_CHECK(!group.isPoweredDown(0));
+}
+
+void testWakeUpClock()
+{
+    MockPowerDriver driver(1);
+    Bar bar(&driver, 0, MatrixPreset::BL28_3005SK);
+    Group group(&driver);
+    group.addBar(bar);
+    group.setIdleTimeout(1000);
+    fill(bar, 5);
+
+    // Group driven from its own clock, far from millis()
+    hostMillis = 0;
+    const uint32_t base = 100000;
+    group.show(base);
+    group.show(base + 1000);
+    HOST_CHECK(group.isPoweredDown(0));
+    group.wakeUp(base + 2000);
+    HOST_CHECK(!group.isPoweredDown(0));
+    group.show(base + 2500);
+    HOST_CHECK(!group.isPoweredDown(0)); // idle time restarted on the group clock
+    group.show(base + 3000);
+    HOST_CHECK(group.isPoweredDown(0));
+}
+
+void testBlink()
+{
+    // Hardware blink: no flush needed, never powered down
+    MockPowerDriver driver(1);
+    Bar bar(&driver, 0, MatrixPreset::BL28_3005SK);
+    Group group(&driver);
+    group.addBar(bar);
+    group.setIdleTimeout(1000);
+    fill(bar, 10);
+    hostMillis = 0;
+    bar.blink(1000);
+    HOST_CHECK(bar.isHardwareBlink() && driver.blinkRate[0]);
+    group.show();
+    const uint32_t shows = driver.shows;
+    for (hostMillis = 10; hostMillis <= 5000; hostMillis += 50)
+        group.show();
+    HOST_CHECK(driver.shows == shows);
+    HOST_CHECK(!group.isPoweredDown(0));
+
+    // Software blink: flushed on every show
+    MockPowerDriver swDriver(1);
+    Bar swBar(&swDriver, 0, MatrixPreset::BL28_3005SK);
+    Group swGroup(&swDriver);
+    swGroup.addBar(swBar);
+    fill(swBar, 10);
+    hostMillis = 0;
+    swBar.blink(1000, false);
+    uint16_t dark = 0, lit = 0;
+    for (hostMillis = 0; hostMillis < 1000; hostMillis += 10)
+    {
+        HOST_CHECK(swGroup.show());
+        swDriver.litAtShow ? ++lit : ++dark;
+    }
+    HOST_CHECK(lit == 50 && dark == 50);
+}
+
+void testBudget()
+{
+    MockPowerDriver driver(2);
+    Bar barA(&driver, 0, MatrixPreset::BL28_3005SK);
+    Bar barB(&driver, 1, MatrixPreset::BL28_3005SK);
+    Group group(&driver);
+    group.addBar(barA);
+    group.addBar(barB);
+    hostMillis = 0;
+
+    // CLAMP per device: the topmost segments are hidden for the flush only
+    group.setPowerBudget(10);
+    fill(barA, 20);
+    fill(barB, 6);
+    group.show();
+    HOST_CHECK(driver.litAtShow == 16);
+    HOST_CHECK(group.getStats().overBudget == 1);
+    HOST_CHECK(barA.barmeter().getLitCount() == 20 && barA.getPixelState(19));
+
+    // CLAMP on the total
+    group.setPowerBudget(0, 13);
+    group.show();
+    HOST_CHECK(driver.litAtShow <= 13 && driver.litAtShow >= 11);
+
+    // Under budget: fast path, nothing touched
+    group.setPowerBudget(30, 60);
+    const uint32_t over = group.getStats().overBudget;
+    group.show();
+    HOST_CHECK(driver.litAtShow == 26);
+    HOST_CHECK(group.getStats().overBudget == over);
+
+    // DIM from the brightness set by the sketch, restored once under budget
+    driver.setBrightness(0, 12);
+    driver.setBrightness(1, 9);
+    group.setPowerBudget(10, 0, PowerBudgetAction::DIM);
+    group.show();
+    HOST_CHECK(driver.litAtShow == 26);
+    HOST_CHECK(driver.brightness[0] == 6); // 12 * 10 / 20
+    HOST_CHECK(driver.brightness[1] == 9); // under budget, untouched
+    fill(barA, 8);
+    group.show();
+    HOST_CHECK(driver.brightness[0] == 12);
+}
+
+int main()
+{
+    testIdlePowerDown();
+    testDarkPowerDown();
+    testWakeUpClock();
+    testBlink();
+    testBudget();
+    return hostReport("test_bar_group");
+}
@@ -0,0 +1,124 @@
+/**
+ * @file test_block_golden.cpp
+ * @brief Scrolling and mirror block animations checked against golden frames.
+ *
+ * `block_golden.h` holds one hash per scenario, each hash covering every frame and update
+ * result of the scenario. It was recorded from the `Block` array renderers that `_blockLanes()`
+ * replaced, so the bit-lane engine must reproduce them frame for frame. Scenarios are drawn
+ * from a fixed pseudo-random sequence: bar length, animation, block length, spacing and count,
+ * plus logic and direction toggles and emission stop/resume while running.
+ *
+ * Run with `--record` to print a new `block_golden.h` from the sources it is built against.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+#include "block_golden.h"
+
+static const uint16_t SCENARIOS = 300;
+static const uint16_t TICKS = 1500;
+
+/** @brief Deterministic generator, independent of the C library rand(). */
+struct Lcg
+{
+    uint32_t state;
+    uint32_t below(uint32_t n)
+    {
+        state = state * 1664525UL + 1013904223UL;
+        return (state >> 8) % n;
+    }
+};
+
+typedef SBK_BarFrame<96> Frame;
+
+uint32_t runScenario(uint16_t idx)
+{
+    static Frame frame;
+    static SBK_BarMeterAnimations<Frame> anim(frame);
+    Lcg rng = {(uint32_t)(0x9E3779B9UL ^ (idx * 2654435761UL))};
+
+    const uint8_t segs = 1 + rng.below(90);
+    const uint8_t kind = rng.below(4);
+    const uint8_t length = 1 + rng.below(5);
+    const uint8_t spacing = rng.below(5);
+    const uint8_t blocks = rng.below(7);
+    const uint16_t intv = 5 + rng.below(20);
+    const bool loop = rng.below(4) != 0;
+
+    frame.setSegsNum(segs);
+    frame.clear();
+    anim.setSegsNum(segs);
+    anim.stop().animInit();
+    switch (kind)
+    {
+    case 0: anim.scrollingUpBlocks(intv, length, spacing, blocks); break;
+    case 1: anim.scrollingDownBlocks(intv, length, spacing, blocks); break;
+    case 2: anim.collidingBlocks(intv, length, spacing, blocks); break;
+    default: anim.explodingBlocks(intv, length, spacing, blocks); break;
+    }
+    if (loop)
+        anim.loop();
+
+    uint32_t hash = 2166136261UL; // FNV-1a
+    uint32_t now = 0;
+    bool emissionStopped = false;
+    for (uint16_t t = 0; t < TICKS; ++t)
+    {
+        if (rng.below(200) == 0)
+            anim.toggleLogic();
+        if (rng.below(300) == 0)
+            anim.toggleDir();
+        if (rng.below(250) == 0)
+        {
+            emissionStopped = !emissionStopped;
+            if (emissionStopped)
+                anim.stopBlockEmission();
+            else
+                anim.resumeBlockEmission();
+        }
+        now += 1 + rng.below(intv);
+        const bool running = anim.update(now);
+        hash = (hash ^ running) * 16777619UL;
+        for (uint8_t s = 0; s < segs; s += 8)
+        {
+            uint8_t bits = 0;
+            for (uint8_t b = 0; b < 8 && s + b < segs; ++b)
+                bits |= (uint8_t)(frame.getPixelState(s + b) ? 1 : 0) << b;
+            hash = (hash ^ bits) * 16777619UL;
+        }
+    }
+    return hash;
+}
+
+int main(int argc, char **argv)
+{
+    if (argc > 1 && !strcmp(argv[1], "--record"))
+    {
+        printf("// Golden frame hashes for test_block_golden.cpp, printed by `test_block_golden --record`.\n");
+        printf("// Recorded from the Block array scrolling/mirror renderers, before the bit-lane engine.\n\n");
+        printf("#pragma once\n\n#include <stdint.h>\n\n");
+        printf("static const uint32_t BLOCK_GOLDEN[%u] = {", SCENARIOS);
+        for (uint16_t i = 0; i < SCENARIOS; ++i)
+            printf("%s0x%08lX%s", i % 6 ? " " : "\n    ", (unsigned long)runScenario(i), i + 1 < SCENARIOS ? "," : "");
+        printf("};\n");
+        return 0;
+    }
+
+    uint16_t mismatched = 0;
+    for (uint16_t i = 0; i < SCENARIOS; ++i)
+        if (runScenario(i) != BLOCK_GOLDEN[i])
+        {
+            fprintf(stderr, "  scenario %u differs from its golden frames\n", i);
+            ++mismatched;
+        }
+    printf("  %u scenarios of %u updates\n", SCENARIOS, TICKS);
+    HOST_CHECK(mismatched == 0);
+    return hostReport("test_block_golden");
+}
@@ -0,0 +1,132 @@
+/**
+ * @file test_clip.cpp
+ * @brief Clip playback: the diff-draw must match a full redraw across logic and direction changes.
+ *
+ * `_clipDraw()` writes only the segments that differ from the frame last drawn. Toggling the
+ * logic or the bar direction mid-clip changes every segment, so the next frame must be drawn in
+ * full. Random clips are played with random toggles and each frame is checked against the
+ * frame drawn from scratch.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+/** @brief Deterministic generator, independent of the C library rand(). */
+struct Lcg
+{
+    uint32_t state;
+    uint32_t below(uint32_t n)
+    {
+        state = state * 1664525UL + 1013904223UL;
+        return (state >> 8) % n;
+    }
+};
+
+typedef SBK_BarFrame<32> Frame;
+
+static Frame frame;
+static SBK_BarMeterAnimations<Frame> anim(frame);
+
+uint32_t shown()
+{
+    uint32_t bits = 0;
+    for (uint8_t i = 0; i < frame.getSegsNum(); ++i)
+        bits |= (uint32_t)frame.getPixelState(i) << i;
+    return bits;
+}
+
+void start(uint8_t segs, const SBK_BarClip &clip)
+{
+    frame.setSegsNum(segs);
+    frame.clear();
+    anim.setSegsNum(segs);
+    anim.stop().animInit();
+    anim.playClip(clip, 10);
+}
+
+void testLogicToggle()
+{
+    static const uint8_t data[] = {0x1F, 0x3F};
+    const SBK_BarClip clip = {data, 2, 8, 0};
+    start(8, clip);
+    anim.update(0);
+    HOST_CHECK(shown() == 0x1F);
+    anim.toggleLogic();
+    anim.update(10);
+    HOST_CHECK(shown() == 0xC0);
+}
+
+void testDirToggle()
+{
+    static const uint8_t data[] = {0x01, 0x03};
+    const SBK_BarClip clip = {data, 2, 8, 0};
+    start(8, clip);
+    anim.update(0);
+    HOST_CHECK(shown() == 0x01);
+    anim.toggleDir();
+    anim.update(10);
+    HOST_CHECK(shown() == 0xC0);
+
+    // Bar longer than the clip: segments drawn before the change are cleared
+    start(12, clip);
+    anim.update(0);
+    anim.toggleDir();
+    anim.update(10);
+    HOST_CHECK(shown() == 0xC00);
+}
+
+void testRandomToggles()
+{
+    static uint8_t data[64 * 4];
+    Lcg rng = {2024};
+    for (uint16_t scenario = 0; scenario < 200; ++scenario)
+    {
+        const uint8_t segs = 1 + rng.below(32);
+        const uint8_t bytes = (segs + 7) / 8;
+        const uint16_t frames = 1 + rng.below(64);
+        for (uint16_t i = 0; i < frames * bytes; ++i)
+            data[i] = rng.below(256);
+        const SBK_BarClip clip = {data, frames, segs, 0};
+        start(segs, clip);
+
+        bool inverted = false, reversed = false;
+        for (uint16_t f = 0; f < frames; ++f)
+        {
+            const uint32_t r = f ? rng.below(8) : 8; // the first update starts the clip
+            if (r == 0)
+            {
+                anim.toggleLogic();
+                inverted = !inverted;
+            }
+            else if (r == 1)
+            {
+                anim.toggleDir();
+                reversed = !reversed;
+            }
+            anim.update(f * 10);
+
+            uint32_t expect = 0;
+            for (uint8_t i = 0; i < segs; ++i)
+                if (((data[f * bytes + i / 8] >> (i % 8)) & 1) != inverted)
+                    expect |= 1UL << (reversed ? segs - 1 - i : i);
+            HOST_CHECK(shown() == expect);
+            if (hostFailures > 20)
+                return;
+        }
+    }
+}
+
+int main()
+{
+    testLogicToggle();
+    testDirToggle();
+    testRandomToggles();
+    return hostReport("test_clip");
+}
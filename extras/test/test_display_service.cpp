@@ -0,0 +1,141 @@
+/**
+ * @file test_display_service.cpp
+ * @brief Command queue (SBK_BarDisplayService.h) fed by several producer threads.
+ *
+ * Producers push numbered items concurrently while one consumer drains the queue: every item
+ * must arrive exactly once, in order per producer. The display service must then apply every
+ * accepted command, and count every rejected one as dropped.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+static const uint8_t PRODUCERS = 4;
+static const uint32_t ITEMS = 50000; // per producer
+
+struct Item
+{
+    uint8_t producer;
+    uint32_t seq;
+};
+
+void testQueue()
+{
+    static SBK_BarMpscQueue<Item, 16> queue;
+    std::atomic<bool> started(false);
+    std::atomic<uint8_t> finished(0);
+    std::thread producers[PRODUCERS];
+
+    for (uint8_t p = 0; p < PRODUCERS; ++p)
+        producers[p] = std::thread([&, p]() {
+            while (!started)
+                std::this_thread::yield();
+            for (uint32_t seq = 0; seq < ITEMS; ++seq)
+            {
+                const Item item = {p, seq};
+                while (!queue.push(item)) // full: wait for the consumer
+                    std::this_thread::yield();
+            }
+            ++finished;
+        });
+
+    uint32_t next[PRODUCERS] = {0};
+    uint32_t received = 0, outOfOrder = 0, badProducer = 0;
+    started = true;
+    for (;;)
+    {
+        const bool done = finished == PRODUCERS;
+        Item item;
+        if (!queue.pop(item))
+        {
+            if (done)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        ++received;
+        if (item.producer >= PRODUCERS)
+            ++badProducer;
+        else if (item.seq != next[item.producer]++)
+            ++outOfOrder;
+    }
+    for (uint8_t p = 0; p < PRODUCERS; ++p)
+        producers[p].join();
+
+    printf("  queue: %u items received from %u producers\n", received, PRODUCERS);
+    HOST_CHECK(badProducer == 0);
+    HOST_CHECK(outOfOrder == 0);
+    HOST_CHECK(received == PRODUCERS * ITEMS);
+}
+
+typedef SBK_BarDrive<MockDriver> Bar;
+typedef SBK_BarDisplayService<Bar, 2, 8> Service;
+
+static uint32_t applied[2]; // display task only
+
+void addArg(Bar &, const Service::Command &cmd) { applied[cmd.bar] += cmd.a; }
+
+void testService()
+{
+    static MockDriver driver(2);
+    static Bar barA(&driver, 0, MatrixPreset::BL28_3005SK);
+    static Bar barB(&driver, 1, MatrixPreset::BL28_3005SK);
+    static Service display;
+    display.addBar(barA);
+    display.addBar(barB);
+
+    std::atomic<bool> started(false);
+    std::atomic<uint8_t> finished(0);
+    std::atomic<uint32_t> accepted[2], rejected(0);
+    accepted[0] = 0;
+    accepted[1] = 0;
+    std::thread producers[PRODUCERS];
+
+    // Producers never retry: a full queue drops the command
+    for (uint8_t p = 0; p < PRODUCERS; ++p)
+        producers[p] = std::thread([&, p]() {
+            while (!started)
+                std::this_thread::yield();
+            for (uint32_t i = 0; i < ITEMS / 10; ++i)
+            {
+                const uint8_t bar = (p + i) & 1;
+                if (display.call(bar, addArg, 1 + (i & 7)))
+                    accepted[bar] += 1 + (i & 7);
+                else
+                    ++rejected;
+                if ((i & 7) == 0)
+                    std::this_thread::yield();
+            }
+            ++finished;
+        });
+
+    started = true;
+    while (finished != PRODUCERS)
+    {
+        ++hostMillis;
+        display.update();
+        std::this_thread::yield();
+    }
+    for (uint8_t p = 0; p < PRODUCERS; ++p)
+        producers[p].join();
+    display.update();
+
+    printf("  service: %u commands dropped\n", display.getDropped());
+    HOST_CHECK(applied[0] == accepted[0]);
+    HOST_CHECK(applied[1] == accepted[1]);
+    HOST_CHECK(display.getDropped() == rejected);
+}
+
+int main()
+{
+    testQueue();
+    testService();
+    return hostReport("test_display_service");
+}
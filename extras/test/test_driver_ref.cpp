@@ -0,0 +1,118 @@
+/**
+ * @file test_driver_ref.cpp
+ * @brief Type-erased driver (SBK_BarDriverRef.h): same output as the direct driver, and its frame cache cost.
+ *
+ * Bars are run through `SBK_BarDrive<SBK_BarDriverRef>` and through the driver type directly, side
+ * by side for 2000 frames; the wrapped and direct driver buffers must match after every show.
+ * Two bars share one ref on two devices so the cache switches device on every frame. The cost
+ * check counts the wrapped driver calls of a column-major BL28 bar, which touches a different
+ * row on nearly every segment.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+typedef SBK_BarDrive<MockPowerDriver> Direct;
+typedef SBK_BarDrive<SBK_BarDriverRef> Ref;
+
+template <typename BarT>
+void start(BarT &bar, uint8_t kind, uint16_t *sig)
+{
+    auto &anim = bar.animations();
+    anim.animInit();
+    switch (kind)
+    {
+    case 0: anim.explodingBlocks(10); break;
+    case 1: anim.bounceFillUpIntv(10, 10); break;
+    case 2: anim.followSignalSmooth(sig); break;
+    default: anim.upStackingBlocks(10); break;
+    }
+    anim.loop();
+}
+
+void testEquivalence()
+{
+    MockPowerDriver direct(2), wrapped(2);
+    SBK_BarDriverRef ref(&wrapped);
+    Direct d0(&direct, 0, MatrixPreset::BL28_3005SK), d1(&direct, 1, MatrixPreset::BL28_3005SK);
+    Ref r0(&ref, 0, MatrixPreset::BL28_3005SK), r1(&ref, 1, MatrixPreset::BL28_3005SK);
+    d1.barmeter().setChangeTracking(true);
+    r1.barmeter().setChangeTracking(true);
+
+    uint16_t sig = 0;
+    uint16_t mismatches = 0;
+    uint32_t t = 1000;
+    for (uint16_t frame = 0; frame < 2000; ++frame, t += 7)
+    {
+        if (frame % 500 == 0)
+        {
+            start(d0, frame / 500, &sig);
+            start(r0, frame / 500, &sig);
+            start(d1, 3 - frame / 500, &sig);
+            start(r1, 3 - frame / 500, &sig);
+        }
+        sig = (uint16_t)((t * 3) & 1023);
+        hostMillis = t;
+        d0.animations().update(t);
+        r0.animations().update(t);
+        d1.animations().update(t);
+        r1.animations().update(t);
+        d0.show();
+        r0.show();
+        if (memcmp(direct.rows, wrapped.rows, sizeof(direct.rows)))
+            ++mismatches;
+    }
+    HOST_CHECK(mismatches == 0);
+    HOST_CHECK(wrapped.setLeds <= direct.setLeds);
+
+    // Optional driver API forwarded
+    HOST_CHECK(ref.setBlinkRate(0, 1) && wrapped.blinkRate[0] == 1);
+    HOST_CHECK(ref.shutdown(1, true) && wrapped.down[1]);
+}
+
+void testCacheCost()
+{
+    MockDriver wrapped(1);
+    SBK_BarDriverRef ref(&wrapped);
+    Ref bar(&ref, 0, MatrixPreset::BL28_3005SK);
+
+    // First frame: every row read once, written back in one pass
+    for (uint8_t i = 0; i < 28; ++i)
+        bar.setPixel(i, true);
+    bar.show();
+    HOST_CHECK(wrapped.setLeds == 28);
+    HOST_CHECK(wrapped.getLeds <= 8 * 8);
+
+    // Next frames: served from the cache kept across show()
+    const uint32_t reads = wrapped.getLeds;
+    for (uint8_t i = 0; i < 28; ++i)
+        bar.setPixel(i, i & 1);
+    bar.show();
+    HOST_CHECK(wrapped.getLeds == reads);
+    HOST_CHECK(wrapped.setLeds == 28 + 14);
+
+    // Writes toggled back before the show cost nothing
+    bar.setPixel(3, false);
+    bar.setPixel(3, true);
+    bar.show();
+    HOST_CHECK(wrapped.setLeds == 28 + 14);
+
+    // Direct writes to the wrapped driver are picked up after invalidate()
+    wrapped.setLed(0, 0, 0, true);
+    ref.invalidate();
+    HOST_CHECK(ref.getLed(0, 0, 0));
+}
+
+int main()
+{
+    testEquivalence();
+    testCacheCost();
+    return hostReport("test_driver_ref");
+}
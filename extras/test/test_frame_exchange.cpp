@@ -0,0 +1,170 @@
+/**
+ * @file test_frame_exchange.cpp
+ * @brief Render/transmit split (SBK_BarFrameExchange.h) exercised from two threads.
+ *
+ * A producer thread publishes numbered frames while a consumer thread takes them: every frame
+ * received must be complete (no mix of two frames) and newer than the previous one, and the
+ * last frame published must be the one finally transmitted to the driver.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+static const uint32_t FRAMES = 200000;
+
+struct Payload
+{
+    uint32_t seq;
+    uint32_t words[15];
+};
+
+void testTripleBuffer()
+{
+    static SBK_BarTripleBuffer<Payload> exchange;
+    std::atomic<bool> started(false), done(false);
+
+    std::thread producer([&]() {
+        while (!started)
+            std::this_thread::yield();
+        for (uint32_t seq = 1; seq <= FRAMES; ++seq)
+        {
+            Payload &p = exchange.back();
+            p.seq = seq;
+            for (uint8_t i = 0; i < 15; ++i)
+                p.words[i] = seq * (i + 1);
+            exchange.publish();
+            if ((seq & 15) == 0)
+                std::this_thread::yield(); // interleave on single-core hosts too
+        }
+        done = true;
+    });
+
+    uint32_t last = 0, received = 0, torn = 0, stale = 0;
+    started = true;
+    for (;;)
+    {
+        const bool finished = done;
+        if (!exchange.acquire())
+        {
+            if (finished)
+                break;
+            std::this_thread::yield();
+            continue;
+        }
+        const Payload &p = exchange.front();
+        for (uint8_t i = 0; i < 15; ++i)
+            if (p.words[i] != p.seq * (i + 1))
+            {
+                ++torn;
+                break;
+            }
+        if (p.seq <= last)
+            ++stale;
+        last = p.seq;
+        ++received;
+    }
+    producer.join();
+
+    printf("  triple buffer: %u of %u frames received\n", received, FRAMES);
+    HOST_CHECK(torn == 0);
+    HOST_CHECK(stale == 0);
+    HOST_CHECK(last == FRAMES);
+}
+
+void testSplitDriver()
+{
+    static MockDriver driver(2);
+    static SBK_BarSplitDriver<MockDriver, 2, 8> split(&driver);
+    std::atomic<bool> started(false), done(false);
+
+    // Frame k: every row of device 0 shows k, every row of device 1 shows ~k
+    std::thread render([&]() {
+        while (!started)
+            std::this_thread::yield();
+        for (uint32_t k = 1; k <= FRAMES / 4; ++k)
+        {
+            for (uint8_t r = 0; r < 8; ++r)
+                for (uint8_t c = 0; c < 8; ++c)
+                {
+                    split.setLed(0, r, c, (k >> c) & 1);
+                    split.setLed(1, r, c, !((k >> c) & 1));
+                }
+            split.show();
+            if ((k & 3) == 0)
+                std::this_thread::yield();
+        }
+        done = true;
+    });
+
+    uint32_t inconsistent = 0;
+    started = true;
+    for (;;)
+    {
+        const bool finished = done;
+        if (split.transmit())
+        {
+            for (uint8_t r = 0; r < 8; ++r)
+                if (driver.rows[0][r] != driver.rows[0][0] || driver.rows[1][r] != (uint8_t)~driver.rows[0][0])
+                {
+                    ++inconsistent;
+                    break;
+                }
+        }
+        else if (finished)
+            break;
+        else
+            std::this_thread::yield();
+    }
+    render.join();
+
+    printf("  split driver: %u frames transmitted, %u LED writes\n", split.getTransmittedFrames(), driver.setLeds);
+    HOST_CHECK(inconsistent == 0);
+    HOST_CHECK(driver.rows[0][0] == (uint8_t)(FRAMES / 4));
+    HOST_CHECK(driver.shows == split.getTransmittedFrames());
+}
+
+void testBarOverSplit()
+{
+    static MockDriver driver(1);
+    static SBK_BarSplitDriver<MockDriver, 1, 8> split(&driver);
+    static SBK_BarDrive<SBK_BarSplitDriver<MockDriver, 1, 8>> bar(&split, 0, MatrixPreset::BL28_3005SK);
+    std::atomic<bool> done(false);
+
+    std::thread render([&]() {
+        bar.animations().animInit().bounceFillUpIntv(2).loop();
+        for (hostMillis = 0; hostMillis < 5000; ++hostMillis)
+        {
+            bar.animations().update();
+            bar.show();
+        }
+        done = true;
+    });
+
+    while (!done)
+        if (!split.transmit())
+            std::this_thread::yield();
+    render.join();
+    split.transmit();
+
+    uint8_t mismatched = 0;
+    for (uint8_t r = 0; r < 8; ++r)
+        for (uint8_t c = 0; c < 8; ++c)
+            if (driver.getLed(0, r, c) != split.getLed(0, r, c))
+                ++mismatched;
+    HOST_CHECK(mismatched == 0);
+}
+
+int main()
+{
+    testTripleBuffer();
+    testSplitDriver();
+    testBarOverSplit();
+    return hostReport("test_frame_exchange");
+}
@@ -0,0 +1,105 @@
+/**
+ * @file test_no_heap.cpp
+ * @brief Zero-heap build (SBK_BARDRIVE_NO_HEAP): no animation may reach operator new.
+ *
+ * The global allocation operators are replaced by counting ones. Two bars then run every
+ * animation that allocates in the heap build (blocks, particles, random pixel order) at the
+ * same time, and not a single allocation may be counted.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#define SBK_BARDRIVE_NO_HEAP
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+static bool heapTrapArmed = false;
+static uint32_t heapAllocs = 0;
+
+void *operator new(size_t size)
+{
+    if (heapTrapArmed)
+        ++heapAllocs;
+    void *p = malloc(size ? size : 1);
+    if (!p)
+        throw std::bad_alloc();
+    return p;
+}
+void *operator new[](size_t size) { return operator new(size); }
+void operator delete(void *p) noexcept { free(p); }
+void operator delete[](void *p) noexcept { free(p); }
+void operator delete(void *p, size_t) noexcept { free(p); }
+void operator delete[](void *p, size_t) noexcept { free(p); }
+
+typedef SBK_BarDrive<MockDriver> Bar;
+
+void startAnim(Bar &bar, uint8_t idx)
+{
+    SBK_BarMeterAnimations<SBK_BarMeter<MockDriver>> &anim = bar.animations();
+    anim.stop().animInit();
+    switch (idx)
+    {
+    case 0: anim.explodingBlocks(10); break;
+    case 1: anim.collidingBlocks(10, 1, 1); break;
+    case 2: anim.scrollingUpBlocks(10, 1, 0); break;
+    case 3: anim.scrollingDownBlocks(10, 2, 1, 5); break;
+    case 4: anim.downStackingBlocks(10); break;
+    case 5: anim.upUnstackingBlocks(10); break;
+    case 6: anim.upStackingBlocks(10, 2, 1); break;
+    case 7: anim.downUnstackingBlocks(10); break;
+    case 8: anim.randomFill(5); break;
+    case 9: anim.randomEmpty(5); break;
+    case 10: anim.bouncingParticles(10, 8); break;
+    case 11: anim.downStackingParticles(10, 8); break;
+    default: anim.upStackingParticles(10, 8); break;
+    }
+    anim.loop();
+}
+
+int main()
+{
+    static MockDriver driver(2);
+    static Bar barA(&driver, 0, MatrixPreset::BL28_3005SK);
+    static Bar barB(&driver, 1, MatrixPreset::BL28_3005SA);
+
+    // The trap itself must count
+    heapTrapArmed = true;
+    void *volatile probe = ::operator new(1);
+    ::operator delete(probe);
+    heapTrapArmed = false;
+    HOST_CHECK(heapAllocs == 1);
+    heapAllocs = 0;
+
+    heapTrapArmed = true;
+    uint8_t idleAnims = 0;
+    for (uint8_t idx = 0; idx < 13; ++idx)
+    {
+        startAnim(barA, idx);
+        startAnim(barB, (idx + 5) % 13); // another animation on the second bar at the same time
+        uint32_t lit = 0;
+        for (uint16_t t = 0; t < 3000; ++t)
+        {
+            hostMillis += 3;
+            barA.animations().update();
+            barB.animations().update();
+            for (uint8_t r = 0; r < 8; ++r)
+                lit += __builtin_popcount(driver.rows[0][r]) + __builtin_popcount(driver.rows[1][r]);
+        }
+        if (!lit)
+            ++idleAnims;
+    }
+    barA.animations().stop();
+    barB.animations().stop();
+    heapTrapArmed = false;
+
+    printf("  %u heap allocations\n", heapAllocs);
+    HOST_CHECK(heapAllocs == 0);
+    HOST_CHECK(idleAnims == 0);
+    return hostReport("test_no_heap");
+}
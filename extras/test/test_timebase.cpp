@@ -0,0 +1,78 @@
+/**
+ * @file test_timebase.cpp
+ * @brief Timebase-locked timeline position checked against the full-width closed form.
+ *
+ * An animation attached to a `SBK_BarTimebase` advances its position incrementally in 32-bit
+ * math. It must still land exactly on `elapsed * |speed| / 100 + phaseOffset` (as a 64-bit
+ * product truncated to 32 bits) across small and long steps, speed changes and restarts.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ */
+
+#include <Arduino.h>
+#include "MockDriver.h"
+#include <SBK_BarDrive.h>
+
+/** @brief Deterministic generator, independent of the C library rand(). */
+struct Lcg
+{
+    uint32_t state;
+    uint32_t below(uint32_t n)
+    {
+        state = state * 1664525UL + 1013904223UL;
+        return (state >> 8) % n;
+    }
+};
+
+typedef SBK_BarFrame<96> Frame;
+
+static const int16_t SPEEDS[] = {100, 250, -50, 7, -100, 32767, -32767, 1};
+
+uint32_t expected(uint32_t elapsed, int16_t speed, uint32_t offset, uint32_t dur)
+{
+    uint32_t pos = (uint32_t)(((uint64_t)elapsed * abs(speed)) / 100) + offset;
+    pos %= dur;
+    return speed < 0 ? dur - pos : pos;
+}
+
+int main()
+{
+    Frame frame;
+    SBK_BarMeterAnimations<Frame> anim(frame);
+    frame.setSegsNum(96);
+    anim.setSegsNum(96);
+    anim.fillUpIntv(1000).loop();
+
+    Lcg rng = {12345};
+    uint32_t now = 0xFFFF0000UL; // crosses the millis() wrap
+    SBK_BarTimebase timebase(now);
+    const uint32_t offset = 777;
+    anim.attachTimebase(timebase, offset);
+    const uint32_t dur = anim.getDuration();
+    HOST_CHECK(dur == 96000UL);
+
+    int16_t speed = 100;
+    for (uint32_t n = 0; n < 200000UL; ++n)
+    {
+        const uint32_t r = rng.below(1000);
+        if (r == 0)
+            now += 1000000UL + rng.below(4000000000UL); // long gap
+        else if (r < 3)
+            timebase.restart(now - rng.below(50000));
+        else if (r < 4)
+            timebase.restart(timebase.origin() - rng.below(50)); // elapsed jumps forward a little
+        else if (r < 10)
+            anim.setSpeed(speed = SPEEDS[rng.below(sizeof(SPEEDS) / sizeof(SPEEDS[0]))]);
+        else
+            now += rng.below(r < 900 ? 40 : 70000);
+        anim.update(now);
+        HOST_CHECK(anim.getPosition() == expected(timebase.elapsed(now), speed, offset, dur));
+        if (hostFailures > 20)
+            break;
+    }
+    return hostReport("test_timebase");
+}
@@ -0,0 +1,264 @@
+/**
+ * @file SBK_BarBatch.h
+ * @brief Data-oriented batch animation engine for large numbers of bars.
+ *
+ * This file defines the `SBK_BarBatch` template class. Instead of one `SBK_BarMeterAnimations`
+ * object per bar, each dispatched through a member function pointer, the batch engine keeps
+ * the state of every bar in structure-of-arrays form, grouped by animation type, and updates
+ * all the bars of a type in one tight loop. Only the segments that change are written.
+ *
+ * Supported animation types:
+ * - Fill: fill up one segment per interval, then restart empty (like a looping `fillUpIntv()`).
+ * - Bounce: fill up then empty down, one segment per interval (like a looping `bounceFillUpIntv()`).
+ * - Follow: show a smoothed signal level (like `followSignalSmooth()`).
+ *
+ * The engine does not need `SBK_BARDRIVE_WITH_ANIM`: a wall of bars can leave it undefined and
+ * save the per-bar animation objects entirely.
+ *
+ * @code
+ * SBK_BarBatch<SBK_BarDrive<SBK_MAX72xxHard>, 128> wall;
+ *
+ * void setup() {
+ *     for (uint8_t i = 0; i < 64; ++i)
+ *         wall.addFill(bars[i], 20);
+ *     for (uint8_t i = 64; i < 128; ++i)
+ *         wall.addFollow(bars[i], &levels[i - 64]);
+ * }
+ *
+ * void loop() {
+ *     wall.update();
+ *     driver.show();
+ * }
+ * @endcode
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @class SBK_BarBatch
+ * @brief Structure-of-arrays animation engine updating many bars per animation type.
+ *
+ * @tparam BarT     Bar type, any object exposing `setPixel(uint8_t, uint8_t)` and `getSegsNum()`
+ *                  (e.g., `SBK_BarDrive<...>`, `SBK_BarMeter<...>`, views).
+ * @tparam MAX_BARS Maximum number of bars per animation type. Default is 32.
+ */
+template <typename BarT, uint8_t MAX_BARS = 32>
+class SBK_BarBatch
+{
+public:
+    /**
+     * @brief Add a bar running a looping fill.
+     * @param bar        Target bar.
+     * @param updateIntv Time between segments in milliseconds.
+     * @return Slot index in the fill group, or -1 if full.
+     */
+    int16_t addFill(BarT &bar, uint16_t updateIntv)
+    {
+        if (_fill.num >= MAX_BARS)
+            return -1;
+        const uint8_t i = _fill.num++;
+        _fill.bar[i] = &bar;
+        _fill.segs[i] = bar.getSegsNum();
+        _fill.level[i] = 0;
+        _fill.intv[i] = updateIntv;
+        _fill.last[i] = millis();
+        _clearBar(bar, _fill.segs[i]);
+        return i;
+    }
+
+    /**
+     * @brief Add a bar running a looping fill up / empty down bounce.
+     * @param bar        Target bar.
+     * @param updateIntv Time between segments in milliseconds.
+     * @return Slot index in the bounce group, or -1 if full.
+     */
+    int16_t addBounce(BarT &bar, uint16_t updateIntv)
+    {
+        if (_bounce.num >= MAX_BARS)
+            return -1;
+        const uint8_t i = _bounce.num++;
+        _bounce.bar[i] = &bar;
+        _bounce.segs[i] = bar.getSegsNum();
+        _bounce.level[i] = 0;
+        _bounce.down[i] = false;
+        _bounce.intv[i] = updateIntv;
+        _bounce.last[i] = millis();
+        _clearBar(bar, _bounce.segs[i]);
+        return i;
+    }
+
+    /**
+     * @brief Add a bar following a signal, with exponential smoothing applied once per sampling interval.
+     * @param bar             Target bar.
+     * @param sigPtr          Signal to follow. Must outlive the batch.
+     * @param minMap          Signal value mapped to an empty bar. Default is 0.
+     * @param maxMap          Signal value mapped to a full bar. Default is 1023.
+     * @param smoothingFactor Smoothing, 0 (none) to 99. Default is 30.
+     * @param samplingIntv    Signal sampling interval in milliseconds, as for `followSignalSmooth()`. Default is 5.
+     * @return Slot index in the follow group, or -1 if full.
+     */
+    int16_t addFollow(BarT &bar, const uint16_t *sigPtr, uint16_t minMap = 0, uint16_t maxMap = 1023,
+                      uint8_t smoothingFactor = 30, uint16_t samplingIntv = 5)
+    {
+        if (_follow.num >= MAX_BARS || !sigPtr)
+            return -1;
+        const uint8_t i = _follow.num++;
+        _follow.bar[i] = &bar;
+        _follow.segs[i] = bar.getSegsNum();
+        _follow.level[i] = 0;
+        _follow.sig[i] = sigPtr;
+        _follow.minMap[i] = min(minMap, maxMap);
+        _follow.span[i] = maxMap > _follow.minMap[i] ? maxMap - _follow.minMap[i] : 1;
+        _follow.keep[i] = (uint8_t)(min(smoothingFactor, (uint8_t)99) * 256 / 100);
+        _follow.avg[i] = (uint32_t)*sigPtr << 8;
+        _follow.intv[i] = samplingIntv;
+        _follow.last[i] = millis();
+        _clearBar(bar, _follow.segs[i]);
+        return i;
+    }
+
+    /** @brief Remove every bar from the engine. Bars keep their current segments. */
+    void clear()
+    {
+        _fill.num = 0;
+        _bounce.num = 0;
+        _follow.num = 0;
+    }
+
+    /**
+     * @brief Advance every bar, one pass per animation type.
+     * @param now Optional timestamp.
+     */
+    void update(uint32_t now = millis())
+    {
+        _updateFill(now);
+        _updateBounce(now);
+        _updateFollow(now);
+    }
+
+    /** @brief Get the total number of bars in the engine. */
+    uint16_t getBarsNum() const { return (uint16_t)_fill.num + _bounce.num + _follow.num; }
+
+private:
+    static void _clearBar(BarT &bar, uint8_t segs)
+    {
+        for (uint8_t s = 0; s < segs; ++s)
+            bar.setPixel(s, false);
+    }
+
+    void _updateFill(uint32_t now)
+    {
+        for (uint8_t i = 0; i < _fill.num; ++i)
+        {
+            if (now - _fill.last[i] < _fill.intv[i])
+                continue;
+            _fill.last[i] = now;
+            BarT &bar = *_fill.bar[i];
+            if (_fill.level[i] < _fill.segs[i])
+                bar.setPixel(_fill.level[i]++, true);
+            else
+            {
+                _clearBar(bar, _fill.segs[i]);
+                _fill.level[i] = 0;
+            }
+        }
+    }
+
+    void _updateBounce(uint32_t now)
+    {
+        for (uint8_t i = 0; i < _bounce.num; ++i)
+        {
+            if (now - _bounce.last[i] < _bounce.intv[i])
+                continue;
+            _bounce.last[i] = now;
+            BarT &bar = *_bounce.bar[i];
+            if (!_bounce.down[i])
+            {
+                bar.setPixel(_bounce.level[i]++, true);
+                _bounce.down[i] = _bounce.level[i] >= _bounce.segs[i];
+            }
+            else
+            {
+                bar.setPixel(--_bounce.level[i], false);
+                _bounce.down[i] = _bounce.level[i] > 0;
+            }
+        }
+    }
+
+    void _updateFollow(uint32_t now)
+    {
+        for (uint8_t i = 0; i < _follow.num; ++i)
+        {
+            if (now - _follow.last[i] < _follow.intv[i])
+                continue;
+            _follow.last[i] = now;
+
+            // avg (Q8) += (1 - keep) * (sample - avg), on the magnitude: |diff| < 2^24 times a weight <= 256 fits 32 bits
+            const int32_t sample = (int32_t)*_follow.sig[i] << 8;
+            int32_t avg = (int32_t)_follow.avg[i];
+            const int32_t diff = sample - avg;
+            const uint32_t step = ((uint32_t)(diff < 0 ? -diff : diff) * (uint32_t)(256 - _follow.keep[i])) >> 8;
+            avg += diff < 0 ? -(int32_t)step : (int32_t)step;
+            _follow.avg[i] = (uint32_t)avg;
+
+            int32_t v = (avg >> 8) - _follow.minMap[i];
+            v = v < 0 ? 0 : (v > (int32_t)_follow.span[i] ? (int32_t)_follow.span[i] : v);
+            const uint8_t target = (uint8_t)((v * _follow.segs[i] + (_follow.span[i] >> 1)) / _follow.span[i]);
+
+            uint8_t &level = _follow.level[i];
+            BarT &bar = *_follow.bar[i];
+            while (level < target)
+                bar.setPixel(level++, true);
+            while (level > target)
+                bar.setPixel(--level, false);
+        }
+    }
+
+    // One group of arrays per animation type
+    struct FillGroup
+    {
+        uint8_t num = 0;
+        BarT *bar[MAX_BARS];
+        uint8_t segs[MAX_BARS];
+        uint8_t level[MAX_BARS];
+        uint16_t intv[MAX_BARS];
+        uint32_t last[MAX_BARS];
+    } _fill;
+
+    struct BounceGroup
+    {
+        uint8_t num = 0;
+        BarT *bar[MAX_BARS];
+        uint8_t segs[MAX_BARS];
+        uint8_t level[MAX_BARS];
+        bool down[MAX_BARS];
+        uint16_t intv[MAX_BARS];
+        uint32_t last[MAX_BARS];
+    } _bounce;
+
+    struct FollowGroup
+    {
+        uint8_t num = 0;
+        BarT *bar[MAX_BARS];
+        uint8_t segs[MAX_BARS];
+        uint8_t level[MAX_BARS];
+        uint8_t keep[MAX_BARS]; // smoothing, Q8
+        const uint16_t *sig[MAX_BARS];
+        uint16_t minMap[MAX_BARS];
+        uint16_t span[MAX_BARS];
+        uint32_t avg[MAX_BARS]; // smoothed signal, Q8
+        uint16_t intv[MAX_BARS]; // sampling interval
+        uint32_t last[MAX_BARS];
+    } _follow;
+};
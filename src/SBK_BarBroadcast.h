@@ -0,0 +1,190 @@
+/**
+ * @file SBK_BarBroadcast.h
+ * @brief Render one animation once and mirror it to many bar meters.
+ *
+ * This file defines the `SBK_BarBroadcast` template class. A single `SBK_BarMeterAnimations`
+ * instance renders into an off-screen `SBK_BarFrame`, and the result is fanned out to any
+ * number of registered bars, each with an optional reversed orientation and segment phase
+ * offset. The animation cost is paid once per frame whatever the number of bars, and only
+ * segments that changed since the previous frame are written to the targets.
+ *
+ * Requires `SBK_BARDRIVE_WITH_ANIM`.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "SBK_BarFrame.h"
+#include "SBK_BarMeterAnimations.h"
+#include "SBK_BarDrive.h" // BarDirection
+
+/**
+ * @class SBK_BarBroadcast
+ * @brief One animation controller rendered once and mirrored to many bars.
+ *
+ * Targets can be any object exposing `setPixel(uint8_t, uint8_t)` and `getSegsNum()`,
+ * such as `SBK_BarDrive`, `SBK_BarMeter`, or sub-bar views. Targets shorter than the
+ * broadcast frame only receive the segments they hold.
+ *
+ * @code
+ * SBK_BarBroadcast<28, 12> idle(28);
+ * idle.addBar(bar1);
+ * idle.addBar(bar2, BarDirection::REVERSE);
+ * idle.addBar(bar3, BarDirection::FORWARD, 7); // rotated by 7 segments
+ * idle.animations().animInit().scrollingUpBlocks(40).loop();
+ *
+ * void loop() {
+ *     idle.update();
+ *     driver.show();
+ * }
+ * @endcode
+ *
+ * @tparam MAX_SEGS Maximum number of segments of the broadcast frame.
+ * @tparam MAX_BARS Maximum number of target bars.
+ */
+template <uint8_t MAX_SEGS = 32, uint8_t MAX_BARS = 8>
+class SBK_BarBroadcast
+{
+public:
+    /** @brief Frame type the broadcast animation renders into. */
+    typedef SBK_BarFrame<MAX_SEGS> FrameT;
+
+    /**
+     * @brief Construct a broadcast controller.
+     * @param segsNum Number of segments of the broadcast frame. Clamped to MAX_SEGS.
+     */
+    explicit SBK_BarBroadcast(uint8_t segsNum)
+        : _frame(segsNum), _prevFrame(segsNum), _barAnimations(_frame)
+    {
+        _barAnimations.setSegsNum(_frame.getSegsNum());
+    }
+
+    /**
+     * @brief Register a target bar.
+     *
+     * @tparam BarT      Any bar type exposing `setPixel()` and `getSegsNum()`.
+     * @param bar        Reference to the target bar.
+     * @param direction  Optional target orientation (FORWARD or REVERSE). Default is FORWARD.
+     * @param phaseOffset Optional rotation, in segments, applied before writing to the target. Default is 0.
+     * @return true if the bar was registered, false if MAX_BARS is reached.
+     *
+     * The new target receives the full current frame on the next `update()`.
+     */
+    template <typename BarT>
+    bool addBar(BarT &bar, BarDirection direction = BarDirection::FORWARD, uint8_t phaseOffset = 0)
+    {
+        if (_barsNum >= MAX_BARS)
+            return false;
+        Target &t = _targets[_barsNum++];
+        t.obj = &bar;
+        t.setPixel = &SBK_BarBroadcast::_setPixelThunk<BarT>;
+        t.segsNum = bar.getSegsNum();
+        t.reversed = (direction == BarDirection::REVERSE);
+        t.phaseOffset = _frame.getSegsNum() ? phaseOffset % _frame.getSegsNum() : 0;
+        _fullRefresh = true;
+        return true;
+    }
+
+    /** @brief Unregister all target bars. */
+    void clearBars() { _barsNum = 0; }
+
+    /** @brief Get the number of registered target bars. */
+    uint8_t getBarsNum() const { return _barsNum; }
+
+    /**
+     * @brief Get the broadcast animation controller.
+     * @return Reference to the SBK_BarMeterAnimations rendering into the broadcast frame.
+     */
+    SBK_BarMeterAnimations<FrameT> &animations() { return _barAnimations; }
+
+    /**
+     * @brief Get the broadcast frame.
+     * @return Const reference to the last rendered frame.
+     */
+    const FrameT &frame() const { return _frame; }
+
+    /**
+     * @brief Advance the broadcast animation and mirror changed segments to every target.
+     * @param syncTime Optional timestamp to synchronize animation.
+     * @return true if the animation is still running; false otherwise.
+     *
+     * The driver buffers are updated but not flushed: call the driver `show()` once afterwards.
+     */
+    bool update(uint32_t syncTime = millis())
+    {
+        bool running = _barAnimations.update(syncTime);
+        fanOut();
+        return running;
+    }
+
+    /**
+     * @brief Mirror the changed segments of the broadcast frame to every target.
+     *
+     * Called by `update()`. Can be called directly after drawing into the frame by other means.
+     */
+    void fanOut()
+    {
+        for (uint8_t w = 0; w < FrameT::WORDS; ++w)
+        {
+            const uint32_t bits = _frame.word(w);
+            uint32_t changed = _fullRefresh ? 0xFFFFFFFFUL : (bits ^ _prevFrame.word(w));
+            while (changed)
+            {
+                const uint8_t b = __builtin_ctzl(changed);
+                changed &= changed - 1;
+                const uint16_t seg = (uint16_t)w * 32 + b;
+                if (seg >= _frame.getSegsNum())
+                    break;
+                const uint8_t state = (bits >> b) & 1UL;
+                for (uint8_t i = 0; i < _barsNum; ++i)
+                    _writeTarget(_targets[i], seg, state);
+            }
+            _prevFrame.setWord(w, bits);
+        }
+        _fullRefresh = false;
+    }
+
+protected:
+    struct Target
+    {
+        void *obj;
+        void (*setPixel)(void *, uint8_t, uint8_t);
+        uint8_t segsNum;
+        uint8_t phaseOffset;
+        bool reversed;
+    };
+
+    template <typename BarT>
+    static void _setPixelThunk(void *obj, uint8_t seg, uint8_t state)
+    {
+        static_cast<BarT *>(obj)->setPixel(seg, state);
+    }
+
+    inline void _writeTarget(const Target &t, uint8_t seg, uint8_t state)
+    {
+        const uint8_t n = _frame.getSegsNum();
+        uint16_t s = (uint16_t)seg + t.phaseOffset;
+        if (s >= n)
+            s -= n;
+        if (t.reversed)
+            s = (n - 1) - s;
+        if (s < t.segsNum)
+            t.setPixel(t.obj, s, state);
+    }
+
+    FrameT _frame;
+    FrameT _prevFrame;
+    SBK_BarMeterAnimations<FrameT> _barAnimations;
+    Target _targets[MAX_BARS];
+    uint8_t _barsNum = 0;
+    bool _fullRefresh = true;
+};
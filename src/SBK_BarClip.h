@@ -0,0 +1,220 @@
+/**
+ * @file SBK_BarClip.h
+ * @brief Precomputed bar animation clips: frame tables played back by `SBK_BarMeterAnimations`.
+ *
+ * This file defines the `SBK_BarClip` descriptor and the `SBK_BarClipRecorder` template class.
+ * A clip is a table of frame bitmaps, in RAM or PROGMEM, optionally run-length compressed,
+ * played back by `SBK_BarMeterAnimations::playClip()` at one table read per tick. The recorder
+ * renders any deterministic animation once into a clip, and can print it as a PROGMEM array
+ * to paste into a sketch.
+ *
+ * Frame bitmap: `(segsNum + 7) / 8` bytes, segment `i` in bit `i % 8` of byte `i / 8`.
+ * Raw clip: frames stored back to back. RLE clip: records of one repeat count byte (1–255)
+ * followed by the frame bitmap shown for that many ticks.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "SBK_BarFrame.h"
+
+/**
+ * @struct SBK_BarClip
+ * @brief Descriptor of a frame table played by `SBK_BarMeterAnimations::playClip()`.
+ *
+ * @code
+ * const uint8_t chaseData[] PROGMEM = {0x01, 0x02, 0x04, 0x08};
+ * const SBK_BarClip chase = {chaseData, 4, 8, SBK_BarClip::IN_PROGMEM};
+ * bar.animations().animInit().playClip(chase, 50).loop();
+ * @endcode
+ */
+struct SBK_BarClip
+{
+    static const uint8_t RLE = 0x01;        ///< Flag: records are [repeat count][frame bitmap].
+    static const uint8_t IN_PROGMEM = 0x02; ///< Flag: data is stored in flash (PROGMEM).
+
+    const uint8_t *data; ///< Frame table.
+    uint16_t framesNum;  ///< Number of frames (ticks) in the clip, repeats included.
+    uint8_t segsNum;     ///< Number of segments per frame.
+    uint8_t flags;       ///< Combination of RLE and IN_PROGMEM.
+
+    /** @brief Number of bytes of one frame bitmap. */
+    uint8_t frameBytes() const { return (segsNum + 7) / 8; }
+
+    /** @brief Read one byte of the frame table. */
+    uint8_t byteAt(uint16_t offset) const
+    {
+        return (flags & IN_PROGMEM) ? pgm_read_byte(data + offset) : data[offset];
+    }
+};
+
+/**
+ * @class SBK_BarClipRecorder
+ * @brief Off-screen bar target recording the frames of an animation into an RLE clip.
+ *
+ * The recorder exposes the bar pixel interface, so any `SBK_BarMeterAnimations` can render into it.
+ *
+ * @code
+ * SBK_BarClipRecorder<28, 256> rec(28);
+ * SBK_BarMeterAnimations<SBK_BarClipRecorder<28, 256>> anim(rec);
+ * anim.setSegsNum(28);
+ * anim.animInit().explodingBlocks(40);
+ * rec.record(anim, 40, 4000);          // 100 frames, 40 ms apart
+ * rec.printProgmem(Serial, "explode"); // paste the output in a sketch
+ * bar.animations().animInit().playClip(rec.clip(), 40).loop();
+ * @endcode
+ *
+ * @tparam MAX_SEGS  Maximum number of segments per frame.
+ * @tparam MAX_BYTES Size of the clip buffer, in bytes.
+ */
+template <uint8_t MAX_SEGS = 32, uint16_t MAX_BYTES = 256>
+class SBK_BarClipRecorder : public SBK_BarFrame<MAX_SEGS>
+{
+public:
+    /**
+     * @brief Construct an empty recorder.
+     * @param segsNum Number of segments per frame. Clamped to MAX_SEGS.
+     */
+    explicit SBK_BarClipRecorder(uint8_t segsNum = MAX_SEGS) : SBK_BarFrame<MAX_SEGS>(segsNum) {}
+
+    /** @brief Discard the recorded frames. */
+    void reset()
+    {
+        _size = 0;
+        _framesNum = 0;
+        _lastRecord = 0;
+    }
+
+    /**
+     * @brief Append the current frame to the clip.
+     *
+     * A frame identical to the previous one only increments the previous record repeat count.
+     *
+     * @return true if recorded, false if the buffer is full.
+     */
+    bool capture()
+    {
+        const uint8_t n = _frameBytes();
+        if (_framesNum && _buf[_lastRecord] < 255 && _sameAsRecord(_lastRecord + 1))
+        {
+            ++_buf[_lastRecord];
+            ++_framesNum;
+            return true;
+        }
+        if (_size + 1 + n > MAX_BYTES)
+            return false;
+        _lastRecord = _size;
+        _buf[_size++] = 1;
+        for (uint8_t b = 0; b < n; ++b)
+            _buf[_size++] = _frameByte(b);
+        ++_framesNum;
+        return true;
+    }
+
+    /**
+     * @brief Run an animation on a simulated clock and capture one frame per tick.
+     *
+     * @tparam AnimT     Animation controller rendering into this recorder.
+     * @param anim       Started animation controller.
+     * @param frameIntv  Tick length in milliseconds, the clip playback interval.
+     * @param duration   Recorded length in milliseconds.
+     * @param startTime  Simulated clock start. Default is 0.
+     * @return Number of frames recorded.
+     */
+    template <typename AnimT>
+    uint16_t record(AnimT &anim, uint16_t frameIntv, uint32_t duration, uint32_t startTime = 0)
+    {
+        if (!frameIntv)
+            return _framesNum;
+        for (uint32_t t = 0; t < duration; t += frameIntv)
+        {
+            anim.update(startTime + t);
+            if (!capture())
+                break;
+        }
+        return _framesNum;
+    }
+
+    /**
+     * @brief Get the recorded clip, played from the recorder RAM buffer.
+     * @return Clip descriptor. Valid while the recorder lives and is not reset.
+     */
+    SBK_BarClip clip() const
+    {
+        SBK_BarClip c = {_buf, _framesNum, this->getSegsNum(), SBK_BarClip::RLE};
+        return c;
+    }
+
+    /** @brief Get the number of recorded frames. */
+    uint16_t getFramesNum() const { return _framesNum; }
+
+    /** @brief Get the number of bytes used by the recorded clip. */
+    uint16_t getSize() const { return _size; }
+
+    /**
+     * @brief Print the clip as C source, a PROGMEM array and its `SBK_BarClip` descriptor.
+     * @param stream Output stream (e.g., `Serial`).
+     * @param name   Array name; the descriptor is named `<name>Clip`.
+     */
+    void printProgmem(Stream &stream, const char *name) const
+    {
+        stream.print(F("// "));
+        stream.print(_framesNum);
+        stream.print(F(" frames, "));
+        stream.print(this->getSegsNum());
+        stream.print(F(" segments, RLE, "));
+        stream.print(_size);
+        stream.println(F(" bytes"));
+        stream.print(F("const uint8_t "));
+        stream.print(name);
+        stream.print(F("[] PROGMEM = {"));
+        for (uint16_t i = 0; i < _size; ++i)
+        {
+            if (i % 16 == 0)
+                stream.print(F("\n    "));
+            stream.print(F("0x"));
+            if (_buf[i] < 0x10)
+                stream.print('0');
+            stream.print(_buf[i], HEX);
+            if (i + 1 < _size)
+                stream.print(F(", "));
+        }
+        stream.println(F("};"));
+        stream.print(F("const SBK_BarClip "));
+        stream.print(name);
+        stream.print(F("Clip = {"));
+        stream.print(name);
+        stream.print(F(", "));
+        stream.print(_framesNum);
+        stream.print(F(", "));
+        stream.print(this->getSegsNum());
+        stream.println(F(", SBK_BarClip::RLE | SBK_BarClip::IN_PROGMEM};"));
+    }
+
+protected:
+    inline uint8_t _frameBytes() const { return (this->getSegsNum() + 7) / 8; }
+
+    inline uint8_t _frameByte(uint8_t b) const { return (uint8_t)(this->word(b >> 2) >> ((b & 3) * 8)); }
+
+    bool _sameAsRecord(uint16_t offset) const
+    {
+        for (uint8_t b = 0; b < _frameBytes(); ++b)
+            if (_buf[offset + b] != _frameByte(b))
+                return false;
+        return true;
+    }
+
+    uint8_t _buf[MAX_BYTES];
+    uint16_t _size = 0;
+    uint16_t _framesNum = 0;
+    uint16_t _lastRecord = 0;
+};
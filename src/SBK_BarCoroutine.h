@@ -0,0 +1,283 @@
+/**
+ * @file SBK_BarCoroutine.h
+ * @brief Opt-in C++20 coroutine animations: linear animation scripts resumed by `update()`.
+ *
+ * Instead of a hand-written state machine (`_init`, `_sequenceState`, `_lastUpdate1`...), a custom
+ * animation can be written as a coroutine returning `SBK_BarAnimTask`, suspending itself with
+ * `co_await SBK_BarCoro::delay(ms)` or `co_await SBK_BarCoro::untilLevel(...)`. It is played with
+ * `SBK_BarMeterAnimations::playCoroutine()` and resumed from `update()` when its wait is over.
+ *
+ * Coroutine frames are allocated from a fixed static arena (`SBK_BARDRIVE_CORO_SLOTS` slots of
+ * `SBK_BARDRIVE_CORO_SLOT_SIZE` bytes), never from the heap. A frame too large for a slot, or no
+ * free slot, makes the animation end at once.
+ *
+ * Requires a C++20 compiler (ESP32 with `-std=gnu++2a`, host builds) and `SBK_BARDRIVE_WITH_COROUTINES`
+ * defined before including `SBK_BarDrive.h`. Otherwise this file defines nothing.
+ *
+ * @code
+ * #define SBK_BARDRIVE_WITH_ANIM
+ * #define SBK_BARDRIVE_WITH_COROUTINES
+ * #include <SBK_BarDrive.h>
+ *
+ * SBK_BarAnimTask sweep(SBK_BarMeter<SBK_HT16K33> &bar)
+ * {
+ *     using SBK_BarCoro::delay;
+ *     for (uint8_t i = 0; i < bar.getSegsNum(); ++i)
+ *     {
+ *         bar.setPixel(i, true);
+ *         co_await delay(20);
+ *     }
+ *     co_await delay(500);
+ *     bar.clear();
+ * }
+ *
+ * bar.animations().animInit().playCoroutine(sweep).loop();
+ * @endcode
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(SBK_BARDRIVE_WITH_COROUTINES) && defined(__cpp_impl_coroutine)
+
+/**
+ * @def SBK_BARDRIVE_HAS_COROUTINES
+ * @brief Defined when coroutine animations are requested and supported by the compiler.
+ */
+#define SBK_BARDRIVE_HAS_COROUTINES
+
+#include <coroutine>
+#include <stddef.h>
+
+/**
+ * @def SBK_BARDRIVE_CORO_SLOTS
+ * @brief Number of coroutine frames that can be alive at once. Default is 4.
+ */
+#ifndef SBK_BARDRIVE_CORO_SLOTS
+#define SBK_BARDRIVE_CORO_SLOTS 4
+#endif
+
+/**
+ * @def SBK_BARDRIVE_CORO_SLOT_SIZE
+ * @brief Size in bytes of one coroutine frame slot. Default is 256.
+ */
+#ifndef SBK_BARDRIVE_CORO_SLOT_SIZE
+#define SBK_BARDRIVE_CORO_SLOT_SIZE 256
+#endif
+
+/**
+ * @class SBK_BarCoroArena
+ * @brief Fixed static pool the coroutine frames are allocated from.
+ */
+class SBK_BarCoroArena
+{
+public:
+    /**
+     * @brief Take a free slot.
+     * @param size Requested frame size in bytes.
+     * @return Slot address, or nullptr if the frame is too large or no slot is free.
+     */
+    static void *allocate(size_t size)
+    {
+        Storage &s = _storage();
+        if (size > SBK_BARDRIVE_CORO_SLOT_SIZE)
+            return nullptr;
+        for (uint8_t i = 0; i < SBK_BARDRIVE_CORO_SLOTS; ++i)
+        {
+            if (!s.used[i])
+            {
+                s.used[i] = true;
+                return s.slots[i];
+            }
+        }
+        return nullptr;
+    }
+
+    /** @brief Give a slot back. */
+    static void release(void *p)
+    {
+        Storage &s = _storage();
+        const size_t idx = ((uint8_t *)p - &s.slots[0][0]) / SBK_BARDRIVE_CORO_SLOT_SIZE;
+        if (idx < SBK_BARDRIVE_CORO_SLOTS)
+            s.used[idx] = false;
+    }
+
+    /** @brief Get the number of slots in use. */
+    static uint8_t inUse()
+    {
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < SBK_BARDRIVE_CORO_SLOTS; ++i)
+            n += _storage().used[i];
+        return n;
+    }
+
+private:
+    struct Storage
+    {
+        alignas(max_align_t) uint8_t slots[SBK_BARDRIVE_CORO_SLOTS][SBK_BARDRIVE_CORO_SLOT_SIZE];
+        bool used[SBK_BARDRIVE_CORO_SLOTS];
+    };
+    static Storage &_storage()
+    {
+        static Storage storage = {};
+        return storage;
+    }
+};
+
+/**
+ * @class SBK_BarAnimTask
+ * @brief Return type of coroutine animations. Owns the coroutine frame.
+ */
+class SBK_BarAnimTask
+{
+public:
+    struct promise_type
+    {
+        uint32_t now = 0;               // time of the current resume
+        uint32_t wakeAt = 0;            // scheduled time of the next resume
+        const uint16_t *watch = nullptr; // level wait, if any
+        uint16_t level = 0;
+        bool rising = true;
+        bool started = false;
+
+        SBK_BarAnimTask get_return_object() { return SBK_BarAnimTask(Handle::from_promise(*this)); }
+        static SBK_BarAnimTask get_return_object_on_allocation_failure() { return SBK_BarAnimTask(); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {}
+
+        static void *operator new(size_t size) noexcept { return SBK_BarCoroArena::allocate(size); }
+        static void operator delete(void *p) noexcept { SBK_BarCoroArena::release(p); }
+
+        bool ready() const
+        {
+            if (watch)
+                return rising ? (*watch >= level) : (*watch <= level);
+            return (int32_t)(now - wakeAt) >= 0;
+        }
+    };
+    typedef std::coroutine_handle<promise_type> Handle;
+
+    SBK_BarAnimTask() = default;
+    SBK_BarAnimTask(const SBK_BarAnimTask &) = delete;
+    SBK_BarAnimTask &operator=(const SBK_BarAnimTask &) = delete;
+    SBK_BarAnimTask(SBK_BarAnimTask &&other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+    SBK_BarAnimTask &operator=(SBK_BarAnimTask &&other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            _handle = other._handle;
+            other._handle = nullptr;
+        }
+        return *this;
+    }
+    ~SBK_BarAnimTask() { reset(); }
+
+    /** @brief Destroy the coroutine, releasing its arena slot. */
+    void reset()
+    {
+        if (_handle)
+            _handle.destroy();
+        _handle = nullptr;
+    }
+
+    /** @brief Returns true if the task holds a coroutine (false if its frame could not be allocated). */
+    bool valid() const { return (bool)_handle; }
+
+    /** @brief Returns true if the coroutine ran to its end, or is invalid. */
+    bool done() const { return !_handle || _handle.done(); }
+
+    /**
+     * @brief Resume the coroutine if its wait is over.
+     * @param now Current time in milliseconds.
+     * @return true if the coroutine is finished.
+     */
+    bool resume(uint32_t now)
+    {
+        if (done())
+            return true;
+        promise_type &p = _handle.promise();
+        p.now = now;
+        if (!p.started)
+        {
+            p.started = true;
+            p.wakeAt = now;
+        }
+        else if (!p.ready())
+            return false;
+        if (p.watch)
+        {
+            p.watch = nullptr;
+            p.wakeAt = now; // delays restart from the level crossing
+        }
+        _handle.resume();
+        return _handle.done();
+    }
+
+private:
+    explicit SBK_BarAnimTask(Handle h) : _handle(h) {}
+    Handle _handle = nullptr;
+};
+
+/**
+ * @namespace SBK_BarCoro
+ * @brief Awaitables for coroutine animations.
+ */
+namespace SBK_BarCoro
+{
+    /**
+     * @brief Suspend for a time. Delays are scheduled back to back, so a script does not drift.
+     *
+     * `co_await delay(0)` resumes on the next `update()`. Add `using SBK_BarCoro::delay;` in the
+     * coroutine to use it unqualified in place of Arduino `delay()`.
+     */
+    struct delay
+    {
+        explicit delay(uint32_t ms) : _ms(ms) {}
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(SBK_BarAnimTask::Handle h) const noexcept { h.promise().wakeAt += _ms; }
+        void await_resume() const noexcept {}
+
+    private:
+        uint32_t _ms;
+    };
+
+    /**
+     * @brief Suspend until a value reaches a level, e.g. a signal sampled elsewhere in the sketch.
+     * @param value  Watched value. Must outlive the wait.
+     * @param level  Level to reach.
+     * @param rising true to wait for `value >= level` (default), false for `value <= level`.
+     */
+    struct untilLevel
+    {
+        untilLevel(const uint16_t &value, uint16_t level, bool rising = true)
+            : _value(&value), _level(level), _rising(rising) {}
+        bool await_ready() const noexcept { return _rising ? (*_value >= _level) : (*_value <= _level); }
+        void await_suspend(SBK_BarAnimTask::Handle h) const noexcept
+        {
+            h.promise().watch = _value;
+            h.promise().level = _level;
+            h.promise().rising = _rising;
+        }
+        void await_resume() const noexcept {}
+
+    private:
+        const uint16_t *_value;
+        uint16_t _level;
+        bool _rising;
+    };
+} // namespace SBK_BarCoro
+
+#endif // SBK_BARDRIVE_WITH_COROUTINES && __cpp_impl_coroutine
@@ -0,0 +1,325 @@
+/**
+ * @file SBK_BarDisplayService.h
+ * @brief RTOS display service: bar commands posted from any task, applied by one display task.
+ *
+ * This file defines the `SBK_BarMpscQueue` template class, a bounded lock-free
+ * multi-producer/single-consumer queue, and the `SBK_BarDisplayService` template class built on it.
+ * Producer tasks post compact `SBK_BarCommand` records (start `followSignalSmooth`, `toggleLogic()`,
+ * `setDirection()`...) instead of touching `SBK_BarMeterAnimations` state; the display task applies
+ * them between animation updates. Bar state is only ever written by the display task, so no mutex
+ * is needed on the render path.
+ *
+ * Requires `<atomic>` (ESP32, ARM cores, host builds) and `SBK_BARDRIVE_WITH_ANIM`.
+ *
+ * @code
+ * SBK_BarDisplayService<SBK_BarDrive<SBK_HT16K33>> display;
+ * uint8_t vu = display.addBar(bar);
+ *
+ * void audioTask(void *) {  // any task
+ *     display.followSignalSmooth(vu, &level, 20);
+ *     display.toggleLogic(vu);
+ * }
+ *
+ * void displayTask(void *) {  // the only task touching the bars
+ *     for (;;) { display.update(); vTaskDelay(1); }
+ * }
+ * @endcode
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "SBK_BarFrameExchange.h"
+
+#if defined(SBK_BARDRIVE_HAS_ATOMIC) && defined(SBK_BARDRIVE_WITH_ANIM)
+
+/**
+ * @class SBK_BarMpscQueue
+ * @brief Bounded lock-free multi-producer/single-consumer queue.
+ *
+ * Each cell carries a sequence number telling producers and the consumer whose turn it is;
+ * producers claim a cell with one compare-and-swap, the consumer never blocks them.
+ *
+ * @tparam T    Element type (trivially copyable).
+ * @tparam SIZE Capacity, a power of two (2–128).
+ */
+template <typename T, uint8_t SIZE>
+class SBK_BarMpscQueue
+{
+    static_assert(SIZE >= 2 && (SIZE & (SIZE - 1)) == 0, "SBK_BarMpscQueue SIZE must be a power of two");
+
+public:
+    SBK_BarMpscQueue() : _enqueuePos(0)
+    {
+        for (uint8_t i = 0; i < SIZE; ++i)
+            _cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Producer (any task): append an element.
+     * @return true if queued, false if the queue is full.
+     */
+    bool push(const T &value)
+    {
+        uint32_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            Cell &cell = _cells[pos & MASK];
+            const int32_t dif = (int32_t)(cell.seq.load(std::memory_order_acquire) - pos);
+            if (dif == 0)
+            {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    cell.data = value;
+                    cell.seq.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (dif < 0)
+                return false; // full
+            else
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Consumer (single task): take the oldest element.
+     * @return true if an element was taken, false if the queue is empty.
+     */
+    bool pop(T &out)
+    {
+        Cell &cell = _cells[_dequeuePos & MASK];
+        if ((int32_t)(cell.seq.load(std::memory_order_acquire) - (_dequeuePos + 1)) < 0)
+            return false;
+        out = cell.data;
+        cell.seq.store(_dequeuePos + SIZE, std::memory_order_release);
+        ++_dequeuePos;
+        return true;
+    }
+
+private:
+    static const uint32_t MASK = SIZE - 1;
+
+    struct Cell
+    {
+        std::atomic<uint32_t> seq;
+        T data;
+    };
+
+    Cell _cells[SIZE];
+    std::atomic<uint32_t> _enqueuePos;
+    uint32_t _dequeuePos = 0; // consumer owned
+};
+
+/**
+ * @enum SBK_BarCmdOp
+ * @brief Operations carried by `SBK_BarCommand`.
+ */
+enum class SBK_BarCmdOp : uint8_t
+{
+    STOP,                 ///< `animations().stop()`
+    PAUSE,                ///< `animations().pause()`
+    RESUME,               ///< `animations().resume()`
+    LOOP,                 ///< `animations().loop()`
+    NO_LOOP,              ///< `animations().noLoop()`
+    TOGGLE_LOGIC,         ///< `animations().toggleLogic()`
+    SET_DIRECTION,        ///< `setDirection(a8)`
+    CLEAR,                ///< Stop, then clear the bar.
+    FOLLOW_SIGNAL_SMOOTH, ///< `animInit().followSignalSmooth(sig, a, b, c, a8, d).loop()`
+    CALL                  ///< `fn(bar, command)`, any other change
+};
+
+/**
+ * @struct SBK_BarCommand
+ * @brief Compact command record posted to `SBK_BarDisplayService`.
+ * @tparam BarT Bar type of the service.
+ */
+template <typename BarT>
+struct SBK_BarCommand
+{
+    typedef void (*Handler)(BarT &bar, const SBK_BarCommand &cmd);
+
+    SBK_BarCmdOp op;
+    uint8_t bar;         ///< Bar index returned by `addBar()`.
+    uint8_t a8;          ///< 8-bit argument.
+    uint16_t a, b, c, d; ///< 16-bit arguments.
+    const uint16_t *sig; ///< Signal pointer argument.
+    Handler fn;          ///< Handler of CALL commands.
+};
+
+/**
+ * @class SBK_BarDisplayService
+ * @brief Single owner of a set of bars, applying commands posted from other tasks.
+ *
+ * Producer methods (`post()`, `stop()`, `toggleLogic()`...) are safe from any task and never
+ * block; they return false when the queue is full (counted by `getDropped()`). `update()` and
+ * `applyPending()` must only be called from the display task.
+ *
+ * @tparam BarT       Bar type (`SBK_BarDrive<...>` or `SBK_BarDriveView<...>`).
+ * @tparam MAX_BARS   Maximum number of bars. Default is 8.
+ * @tparam QUEUE_SIZE Command queue capacity, a power of two. Default is 16.
+ */
+template <typename BarT, uint8_t MAX_BARS = 8, uint8_t QUEUE_SIZE = 16>
+class SBK_BarDisplayService
+{
+public:
+    typedef SBK_BarCommand<BarT> Command;
+
+    /**
+     * @brief Register a bar. Call before the tasks start.
+     * @return Bar index for the commands, or 0xFF if full.
+     */
+    uint8_t addBar(BarT &bar)
+    {
+        if (_barsNum >= MAX_BARS)
+            return 0xFF;
+        _bars[_barsNum] = &bar;
+        return _barsNum++;
+    }
+
+    /** @brief Producer: post a command. Returns false if the queue is full. */
+    bool post(const Command &cmd)
+    {
+        if (_queue.push(cmd))
+            return true;
+        _dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    /** @brief Producer: post an argument-less operation. */
+    bool post(uint8_t bar, SBK_BarCmdOp op)
+    {
+        Command cmd = {op, bar, 0, 0, 0, 0, 0, nullptr, nullptr};
+        return post(cmd);
+    }
+
+    bool stop(uint8_t bar) { return post(bar, SBK_BarCmdOp::STOP); }
+    bool pause(uint8_t bar) { return post(bar, SBK_BarCmdOp::PAUSE); }
+    bool resume(uint8_t bar) { return post(bar, SBK_BarCmdOp::RESUME); }
+    bool toggleLogic(uint8_t bar) { return post(bar, SBK_BarCmdOp::TOGGLE_LOGIC); }
+    bool clear(uint8_t bar) { return post(bar, SBK_BarCmdOp::CLEAR); }
+
+    /** @brief Producer: set the bar direction. */
+    bool setDirection(uint8_t bar, BarDirection dir)
+    {
+        Command cmd = {SBK_BarCmdOp::SET_DIRECTION, bar, (uint8_t)dir, 0, 0, 0, 0, nullptr, nullptr};
+        return post(cmd);
+    }
+
+    /** @brief Producer: start a looping `followSignalSmooth()` (same arguments). */
+    bool followSignalSmooth(uint8_t bar, const uint16_t *sigPtr, uint16_t updateIntv = 100, uint16_t minMap = 0,
+                            uint16_t maxMap = 1023, uint8_t smoothingFactor = 30, uint16_t samplingIntv = 5)
+    {
+        Command cmd = {SBK_BarCmdOp::FOLLOW_SIGNAL_SMOOTH, bar, smoothingFactor,
+                       updateIntv, minMap, maxMap, samplingIntv, sigPtr, nullptr};
+        return post(cmd);
+    }
+
+    /**
+     * @brief Producer: run any change on the display task.
+     * @param fn Handler called with the bar and the command (`a` carries `arg`).
+     */
+    bool call(uint8_t bar, typename Command::Handler fn, uint16_t arg = 0)
+    {
+        Command cmd = {SBK_BarCmdOp::CALL, bar, 0, arg, 0, 0, 0, nullptr, fn};
+        return post(cmd);
+    }
+
+    /**
+     * @brief Display task: apply every pending command.
+     * @return Number of commands applied.
+     */
+    uint8_t applyPending()
+    {
+        uint8_t n = 0;
+        Command cmd;
+        while (n < QUEUE_SIZE && _queue.pop(cmd))
+        {
+            _apply(cmd);
+            ++n;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Display task: apply pending commands, update the animations and show every bar.
+     *
+     * With several bars sharing a driver, call `applyPending()` then flush through an `SBK_BarGroup`.
+     *
+     * @param now Optional timestamp.
+     */
+    void update(uint32_t now = millis())
+    {
+        applyPending();
+        for (uint8_t i = 0; i < _barsNum; ++i)
+        {
+            _bars[i]->animations().update(now);
+            _bars[i]->show();
+        }
+    }
+
+    /** @brief Get the number of commands dropped because the queue was full. */
+    uint32_t getDropped() const { return _dropped.load(std::memory_order_relaxed); }
+
+    /** @brief Get the number of registered bars. */
+    uint8_t getBarsNum() const { return _barsNum; }
+
+private:
+    void _apply(const Command &cmd)
+    {
+        if (cmd.bar >= _barsNum)
+            return;
+        BarT &bar = *_bars[cmd.bar];
+        switch (cmd.op)
+        {
+        case SBK_BarCmdOp::STOP:
+            bar.animations().stop();
+            break;
+        case SBK_BarCmdOp::PAUSE:
+            bar.animations().pause();
+            break;
+        case SBK_BarCmdOp::RESUME:
+            bar.animations().resume();
+            break;
+        case SBK_BarCmdOp::LOOP:
+            bar.animations().loop();
+            break;
+        case SBK_BarCmdOp::NO_LOOP:
+            bar.animations().noLoop();
+            break;
+        case SBK_BarCmdOp::TOGGLE_LOGIC:
+            bar.animations().toggleLogic();
+            break;
+        case SBK_BarCmdOp::SET_DIRECTION:
+            bar.setDirection((BarDirection)cmd.a8);
+            break;
+        case SBK_BarCmdOp::CLEAR:
+            bar.animations().stop();
+            bar.clear();
+            break;
+        case SBK_BarCmdOp::FOLLOW_SIGNAL_SMOOTH:
+            bar.animations().stop().animInit().followSignalSmooth(cmd.sig, cmd.a, cmd.b, cmd.c, cmd.a8, cmd.d).loop();
+            break;
+        case SBK_BarCmdOp::CALL:
+            if (cmd.fn)
+                cmd.fn(bar, cmd);
+            break;
+        }
+    }
+
+    BarT *_bars[MAX_BARS];
+    uint8_t _barsNum = 0;
+    SBK_BarMpscQueue<Command, QUEUE_SIZE> _queue;
+    std::atomic<uint32_t> _dropped{0};
+};
+
+#endif // SBK_BARDRIVE_HAS_ATOMIC && SBK_BARDRIVE_WITH_ANIM
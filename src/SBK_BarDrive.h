@@ -48,6 +48,9 @@
  * @example splitDriverDevicesBarMeter.ino
  * @brief Example showing how to split a bar meter on multiple driver devices.
  *
+ * @example subBarViews.ino
+ * @brief Example showing how to split one physical bar meter into independent sub-bar views.
+ *
  */
 
 #pragma once
@@ -64,6 +67,29 @@
 #pragma message(" ⚠️ SBK_BARDRIVE_WITH_ANIM is not defined. SBK BarDrive Built-in animations are disabled and cannot be accessed, saving memory if they are not needed. If you do need the animations library, define SBK_BARDRIVE_WITH_ANIM before including SBK_BarDrive.h.")
 #endif
 
+/**
+ * @def SBK_BARDRIVE_MAX_SEGS
+ * @brief Highest segment count covered by per-bar output modulation (software dimming, dithering).
+ *
+ * Each bar reserves one bit per segment up to this value. Segments beyond it are never dimmed.
+ * Define it **before including** `SBK_BarDrive.h` to trade RAM for longer bars. Default is 64.
+ */
+#ifndef SBK_BARDRIVE_MAX_SEGS
+#define SBK_BARDRIVE_MAX_SEGS 64
+#endif
+
+/**
+ * @def SBK_BARDRIVE_NO_HEAP
+ * @brief Zero-heap build mode: the library never calls `new` or `delete`.
+ *
+ * Define this macro **before including** `SBK_BarDrive.h` to serve the working memory of block, particle
+ * and random pixel animations from a fixed pool inside each animation controller, sized by
+ * `SBK_BARDRIVE_MAX_SEGS`. On bars longer than that, scrolling and mirror block animations may end
+ * at once, particle animations end at once and random pixel animations only shuffle the first
+ * segments. Particle animations run 8 particles at most. Coroutine frames always
+ * use their own static arena (see `SBK_BarCoroutine.h`).
+ */
+
 // IMPORTANT: Include the appropriate driver before SBK_BarDrive.h
 // e.g., #include <SBK_MAX72xxSoft.h>, <SBK_MAX72xxHard.h> or <SBK_HT16K33.h>
 #if !defined(SBK_MAX72xx_IS_DEFINED) && !defined(SBK_HT16K33_IS_DEFINED)
@@ -71,6 +97,8 @@
 #endif
 
 #include <Arduino.h>
+#include "SBK_BarFrame.h"
+#include "SBK_DriverTraits.h"
 #ifdef SBK_BARDRIVE_WITH_ANIM
 #include "SBK_BarMeterAnimations.h"
 #endif
@@ -106,6 +134,175 @@ enum class BarDirection : uint8_t
     REVERSE = 1  ///< From last segment to first.
 };
 
+/**
+ * @namespace SBK_BarLayoutError
+ * @brief Compile-time diagnostics of `SBK_BarLayout`.
+ *
+ * These functions are deliberately not `constexpr`: a `constexpr` layout with an invalid argument
+ * reaches one of them and fails to compile, the error naming the problem. Evaluated at run time,
+ * they clamp the argument instead.
+ */
+namespace SBK_BarLayoutError
+{
+    inline uint8_t deviceIndexAbove7(uint8_t devIdx) { return devIdx > 7 ? 7 : devIdx; }
+    inline uint8_t presetNeedsDriverSize_useSegments() { return 0; }
+    inline uint8_t segmentCountIsZero() { return 1; }
+    inline uint8_t matrixSizeIsZero() { return 1; }
+    inline uint8_t matrixAbove255Segments() { return 255; }
+}
+
+/**
+ * @struct SBK_BarLayout
+ * @brief Compile-time bar meter configuration: layout, segment count, offsets and mapping.
+ *
+ * A layout built with one of the `constexpr` factories below holds everything the bar meter
+ * constructors otherwise work out at run time from the driver. Bars constructed from a
+ * `constexpr` layout are constant-initialized: their initial state is part of the program image,
+ * no constructor code runs at boot and the driver is not queried before `begin()`.
+ *
+ * Invalid arguments fail to compile (see `SBK_BarLayoutError`). `fits()` checks the layout
+ * against the driver geometry, for use in a `static_assert`:
+ *
+ * @code
+ * constexpr SBK_BarLayout VU_LAYOUT = SBK_BarLayout::fromPreset(0, MatrixPreset::BL28_3005SK);
+ * static_assert(VU_LAYOUT.fits(1, 8, 16), "VU bar does not fit one 8x16 device");
+ * SBK_BarDrive<SBK_HT16K33> vu(&driver, VU_LAYOUT);
+ * @endcode
+ */
+struct SBK_BarLayout
+{
+    uint8_t devIdx;              ///< Index of the first device (0–7).
+    uint8_t segsNum;             ///< Number of segments.
+    uint8_t rowsNum;             ///< Matrix rows (matrix layouts).
+    uint8_t colsNum;             ///< Matrix columns (matrix layouts).
+    uint8_t rowOffset;           ///< Row offset (matrix layouts, RAM mappings).
+    uint8_t colOffset;           ///< Column offset (matrix layouts, RAM mappings).
+    uint8_t segOffset;           ///< Segment offset (segment layouts).
+    bool isMatrixMapped;         ///< Matrix (column-major) or segment (row-major) addressing.
+    bool progmem;                ///< Custom mapping stored in PROGMEM.
+    BarDirection direction;      ///< Bar fill direction.
+    MatrixPreset matrixPreset;   ///< Preset used, if any.
+    const uint8_t (*mapping)[3]; ///< Custom [device, row, col] mapping, or nullptr.
+
+    /**
+     * @brief Layout of a preset matrix bar meter (same arguments as the preset constructor).
+     *
+     * `MatrixPreset::NONE` depends on the driver size and does not compile: use `segments()`.
+     */
+    static constexpr SBK_BarLayout fromPreset(uint8_t devIdx,
+                                              MatrixPreset matrixPreset,
+                                              BarDirection direction = BarDirection::FORWARD,
+                                              uint8_t rowOffset = 0,
+                                              uint8_t colOffset = 0)
+    {
+        return SBK_BarLayout{_checkDev(devIdx),
+                             _presetSegs(matrixPreset),
+                             _presetRows(matrixPreset),
+                             (uint8_t)(_presetSegs(matrixPreset) / _presetRows(matrixPreset)),
+                             rowOffset, colOffset, 0, true, false, direction, matrixPreset, nullptr};
+    }
+
+    /** @brief Layout of a custom-size matrix bar meter (same arguments as the matrix constructor). */
+    static constexpr SBK_BarLayout matrix(uint8_t devIdx,
+                                          uint8_t rowsNum,
+                                          uint8_t colsNum,
+                                          BarDirection direction = BarDirection::FORWARD,
+                                          uint8_t rowOffset = 0,
+                                          uint8_t colOffset = 0)
+    {
+        return SBK_BarLayout{_checkDev(devIdx),
+                             _checkMatrix(rowsNum, colsNum),
+                             rowsNum, colsNum, rowOffset, colOffset, 0, true, false,
+                             direction, MatrixPreset::NONE, nullptr};
+    }
+
+    /** @brief Layout of a segment bar meter (same arguments as the segment count constructor). */
+    static constexpr SBK_BarLayout segments(uint8_t devIdx,
+                                            uint8_t segsNum,
+                                            BarDirection direction = BarDirection::FORWARD,
+                                            uint8_t segOffset = 0)
+    {
+        return SBK_BarLayout{_checkDev(devIdx),
+                             segsNum ? segsNum : SBK_BarLayoutError::segmentCountIsZero(),
+                             0, 0, 0, 0, segOffset, false, false, direction, MatrixPreset::NONE, nullptr};
+    }
+
+    /** @brief Layout of a custom-mapped bar meter (same arguments as the mapping constructor). */
+    template <size_t N>
+    static constexpr SBK_BarLayout mapped(uint8_t devIdx,
+                                          const uint8_t (&mapping)[N][3],
+                                          BarDirection direction = BarDirection::FORWARD,
+                                          bool progmem = false,
+                                          uint8_t rowOffset = 0,
+                                          uint8_t colOffset = 0)
+    {
+        static_assert(N >= 1 && N <= 255, "SBK_BarLayout mapping must hold 1 to 255 segments");
+        return SBK_BarLayout{_checkDev(devIdx), (uint8_t)N, 0, 0, rowOffset, colOffset, 0, true, progmem,
+                             direction, MatrixPreset::NONE, mapping};
+    }
+
+    /**
+     * @brief Check that every segment lands on the driver.
+     *
+     * Custom mappings are only checked at compile time if the mapping array is declared `constexpr`.
+     *
+     * @param devsNum    Number of driver devices.
+     * @param maxRows    Rows per device.
+     * @param maxColumns Columns per device.
+     * @return true if the layout fits.
+     */
+    constexpr bool fits(uint8_t devsNum, uint8_t maxRows, uint8_t maxColumns) const
+    {
+        return mapping ? _mappingFits(0, devsNum, maxRows, maxColumns)
+               : !maxRows || !maxColumns || devIdx >= devsNum
+                   ? false
+               : isMatrixMapped
+                   ? rowsNum + rowOffset <= maxRows && colsNum + colOffset <= maxColumns &&
+                         devIdx + (segsNum - 1) / (maxRows * maxColumns) < devsNum
+                   : devIdx + (segOffset + segsNum - 1) / (maxRows * maxColumns) < devsNum;
+    }
+
+private:
+    static constexpr uint8_t _checkDev(uint8_t devIdx)
+    {
+        return devIdx <= 7 ? devIdx : SBK_BarLayoutError::deviceIndexAbove7(devIdx);
+    }
+
+    static constexpr MatrixPreset _native(MatrixPreset p)
+    {
+        return p == MatrixPreset::SBK_BarMeter_SK28   ? MatrixPreset::BL28_3005SK
+               : p == MatrixPreset::SBK_BarMeter_SA28 ? MatrixPreset::BL28_3005SA
+                                                      : p;
+    }
+
+    static constexpr uint8_t _presetSegs(MatrixPreset p)
+    {
+        return _native(p) == MatrixPreset::NONE ? SBK_BarLayoutError::presetNeedsDriverSize_useSegments() : 28;
+    }
+
+    static constexpr uint8_t _presetRows(MatrixPreset p)
+    {
+        return _native(p) == MatrixPreset::BL28_3005SA ? 7 : 4;
+    }
+
+    static constexpr uint8_t _checkMatrix(uint8_t rowsNum, uint8_t colsNum)
+    {
+        return !rowsNum || !colsNum                ? SBK_BarLayoutError::matrixSizeIsZero()
+               : (uint16_t)rowsNum * colsNum > 255 ? SBK_BarLayoutError::matrixAbove255Segments()
+                                                   : (uint8_t)(rowsNum * colsNum);
+    }
+
+    // PROGMEM mappings ignore the offsets, as in the mapping constructor
+    constexpr bool _mappingFits(uint8_t i, uint8_t devsNum, uint8_t maxRows, uint8_t maxColumns) const
+    {
+        return i >= segsNum ||
+               (mapping[i][0] < devsNum &&
+                mapping[i][1] + (progmem ? 0 : rowOffset) < maxRows &&
+                mapping[i][2] + (progmem ? 0 : colOffset) < maxColumns &&
+                _mappingFits(i + 1, devsNum, maxRows, maxColumns));
+    }
+};
+
 /**
  * @class SBK_BarMeter
  * @brief Template class for controlling segment-based LED bar meters using row/column mappings.
@@ -312,7 +509,34 @@ public:
         }
     }
 
-    ~SBK_BarMeter() { /* Nothing to clean up for now*/ }
+    /**
+     * @brief Construct a SBK_BarMeter from a compile-time layout.
+     *
+     * @param driver Pointer to the LED driver (e.g., SBK_MAX72xx or SBK_HT16K33).
+     * @param layout Layout built with an `SBK_BarLayout` factory.
+     *
+     * Nothing is computed and the driver is not queried: with a `constexpr` layout, a global
+     * bar meter is constant-initialized and costs no code at boot. The layout is validated at
+     * compile time instead of being clamped (see `SBK_BarLayout::fits()`).
+     */
+    constexpr SBK_BarMeter(DriverT *driver, const SBK_BarLayout &layout)
+        : _driver(driver),
+          _devIdx(layout.devIdx),
+          _matrixPreset(layout.matrixPreset),
+          _customMapping(layout.mapping),
+          _direction(layout.direction),
+          _segOffset(layout.segOffset),
+          _rowOffset(layout.rowOffset),
+          _colOffset(layout.colOffset),
+          _isMatrixMapped(layout.isMatrixMapped),
+          _segsNum(layout.segsNum),
+          _rowsNum(layout.rowsNum),
+          _colsNum(layout.colsNum),
+          _userMappingIsProgmem(layout.progmem)
+    {
+    }
+
+    ~SBK_BarMeter() = default; // trivial, so constant-initialized bars need no exit registration
 
     /**
      * @brief Push the current LED state buffer to the physical display.
@@ -322,8 +546,100 @@ public:
      * (e.g., via `setPixel()` or `clear()`) visible on the actual hardware.
      *
      * Internally calls `_driver->show()` to update the display.
+     *
+     * When software dimming or fractional level dithering is active, the output modulation
+     * of this frame is applied around the driver flush (see `beginCommit()` / `endCommit()`).
+     */
+    void show()
+    {
+        if (!_outputFx)
+        {
+            _driver->show();
+            return;
+        }
+        beginCommit();
+        _driver->show();
+        endCommit();
+    }
+
+    /**
+     * @brief Apply this frame's output modulation to the driver buffer, before a flush.
+     *
+     * Hides the lit segments that must appear dark on this frame (software dimming,
+     * partially lit top segment) and advances the dithering phase. Must be paired with
+     * `endCommit()` right after the driver flush, which restores the hidden segments so
+     * the driver buffer keeps holding the logical bar state.
+     *
+     * `show()` does this automatically. Call it directly when several bars share one
+     * driver and the driver `show()` is called once for all of them:
+     * `beginCommit()` on each bar, `driver.show()`, then `endCommit()` on each bar.
      */
-    void show() { _driver->show(); }
+    void beginCommit()
+    {
+        if (!_outputFx)
+            return;
+
+        const uint8_t phase = _ditherPhase;
+        _ditherPhase = (_ditherPhase + 1) & 0x0F;
+
+        if (_blanked || !((_ditherPattern(_softBrightness + 1) >> phase) & 1))
+        {
+            // Blanked or dimmed-out frame: hide every lit segment
+            for (uint8_t i = 0; i < _segsNum && i < SBK_BARDRIVE_MAX_SEGS; ++i)
+                _hideIfLit(i);
+        }
+        else if (_ditherSeg < _segsNum && !((_ditherPattern(_ditherDuty) >> phase) & 1))
+        {
+            // Only the partially lit top segment is dark on this frame
+            _hideIfLit(_ditherSeg);
+        }
+    }
+
+    /**
+     * @brief Keep at most `maxLit` segments lit for the next flush.
+     *
+     * Lit segments beyond the first `maxLit` (counting from the bar start) are hidden until
+     * `endCommit()`, like a limiter on the displayed level. The logical bar state is kept.
+     * Must be called between `beginCommit()` and the driver flush.
+     *
+     * @param maxLit Maximum number of segments lit on the next flush.
+     */
+    void clampLit(uint8_t maxLit)
+    {
+        uint8_t kept = 0;
+        for (uint8_t i = 0; i < _segsNum && i < SBK_BARDRIVE_MAX_SEGS; ++i)
+        {
+            if (!getPixelState(i))
+                continue;
+            if (kept < maxLit)
+                ++kept;
+            else
+            {
+                _writeLed(i, false);
+                _hidden.setPixel(i, true);
+            }
+        }
+    }
+
+    /**
+     * @brief Restore the segments hidden by `beginCommit()`, after a flush.
+     */
+    void endCommit()
+    {
+        if (_hidden.isEmpty())
+            return;
+        for (uint8_t w = 0; w < _hidden.WORDS; ++w)
+        {
+            uint32_t bits = _hidden.word(w);
+            while (bits)
+            {
+                const uint8_t seg = w * 32 + __builtin_ctzl(bits);
+                bits &= bits - 1;
+                _writeLed(seg, true);
+            }
+        }
+        _hidden.clear();
+    }
 
     /**
      * @brief Clear all bar segments.
@@ -334,6 +650,88 @@ public:
             setPixel(i, false);
     }
 
+    /**
+     * @brief Display a level with sub-segment resolution.
+     *
+     * Lights the segments below the level and renders the fractional part on the top
+     * segment with temporal dithering: that segment is lit on a fraction of consecutive
+     * `show()` calls (1/16 resolution, sigma-delta spread so pulses are evenly distributed).
+     *
+     * @param value    Level to display, from 0 to `maxValue`.
+     * @param maxValue Value of a fully lit bar. Default is 1023 (10-bit ADC).
+     *
+     * The dithered segment is released by any later `setPixel()` on it or by `clear()`.
+     * See `ditherRequiredShowRate()` for the flicker-free refresh rate.
+     */
+    void setFillLevel(uint16_t value, uint16_t maxValue = 1023)
+    {
+        if (!maxValue)
+            return;
+        value = min(value, maxValue);
+        // Level in 1/16 segment units
+        const uint16_t level16 = (uint16_t)(((uint32_t)value * _segsNum * 16UL) / maxValue);
+        const uint8_t full = level16 >> 4;
+        const uint8_t frac = level16 & 0x0F;
+
+        for (uint8_t i = 0; i < _segsNum; ++i)
+            setPixel(i, i < full || (i == full && frac));
+
+        if (frac && full < _segsNum)
+        {
+            _ditherSeg = full;
+            _ditherDuty = frac;
+        }
+        _updateOutputFx();
+    }
+
+    /**
+     * @brief Set the software brightness of this bar only.
+     *
+     * Unlike the driver brightness, which applies to a whole device, this dims a single bar
+     * by blanking its lit segments on a fraction of consecutive `show()` calls.
+     *
+     * @param level Brightness level, 0 (1/16 duty) to 15 (full, no modulation). Default driver level is unchanged.
+     */
+    void setSoftBrightness(uint8_t level)
+    {
+        _softBrightness = min(level, (uint8_t)15);
+        _updateOutputFx();
+    }
+
+    /**
+     * @brief Get the software brightness of this bar.
+     * @return Brightness level (0–15).
+     */
+    uint8_t getSoftBrightness() const { return _softBrightness; }
+
+    /**
+     * @brief Blank the bar on the next flushes without altering its content.
+     *
+     * While blanked, lit segments are hidden around each driver flush and restored right
+     * after, so the bar state is kept and reappears as soon as blanking is released.
+     *
+     * @param blanked true to hide the bar, false to show it.
+     */
+    void setBlanked(bool blanked)
+    {
+        _blanked = blanked;
+        _updateOutputFx();
+    }
+
+    /** @brief Returns true if the bar is currently blanked. */
+    bool isBlanked() const { return _blanked; }
+
+    /**
+     * @brief Minimum `show()` rate for flicker-free dithering and software dimming.
+     *
+     * A 16-step modulation cycle needs 16 frames, so the refresh rate must be 16 times
+     * the desired perceived rate.
+     *
+     * @param flickerFreeHz Perceived modulation rate to reach. Default is 60 Hz.
+     * @return Required number of `show()` calls per second.
+     */
+    static uint16_t ditherRequiredShowRate(uint8_t flickerFreeHz = 60) { return 16U * flickerFreeHz; }
+
     /**
      * @brief Set the bar fill direction.
      * @param dir New direction (FORWARD or REVERSE).
@@ -352,6 +750,35 @@ public:
      */
     uint8_t getSegsNum() const { return _segsNum; }
 
+    /**
+     * @brief Get the index of the first device holding the bar.
+     * @return Device index (0–7).
+     */
+    uint8_t getDevIdx() const { return _devIdx; }
+
+    /**
+     * @brief Get the LED driver of the bar.
+     * @return Pointer to the driver instance.
+     */
+    DriverT *getDriver() const { return _driver; }
+
+    /**
+     * @brief Get the set of driver devices holding at least one segment of the bar.
+     * @return Bit mask, bit n set if device n holds a segment (split bars set several bits).
+     */
+    uint8_t getDevicesMask() const
+    {
+        uint8_t mask = 0;
+        for (uint8_t i = 0; i < _segsNum; ++i)
+        {
+            uint8_t devIdx = _devIdx;
+            uint8_t rowIdx, colIdx;
+            _getMappedDevRowCol(i, &devIdx, &rowIdx, &colIdx);
+            mask |= (uint8_t)(1 << (devIdx & 7));
+        }
+        return mask;
+    }
+
     /**
      * @brief Print the segment-to-device mapping for debugging purposes.
      *
@@ -399,12 +826,93 @@ public:
         if (segment >= _segsNum || !_driver)
             return;
 
+        if (segment == _ditherSeg)
+        {
+            _ditherSeg = NO_SEG;
+            _updateOutputFx();
+        }
+
         uint8_t devIdx = _devIdx;
         uint8_t rowIdx, colIdx;
         _getMappedDevRowCol(segment, &devIdx, &rowIdx, &colIdx);
-        _driver->setLed(devIdx, rowIdx, colIdx, state != 0);
+
+        const bool on = (state != 0);
+        if (!_tracking)
+        {
+            _driver->setLed(devIdx, rowIdx, colIdx, on);
+            _changed = true;
+            _litValid = false;
+            return;
+        }
+
+        // Skip unchanged segments so idle bars stay idle
+        if (_driver->getLed(devIdx, rowIdx, colIdx) == on)
+            return;
+        _driver->setLed(devIdx, rowIdx, colIdx, on);
+        _changed = true;
+        if (_litValid)
+            on ? ++_litCount : --_litCount;
+    }
+
+    /**
+     * @brief Enable or disable change tracking.
+     *
+     * When enabled, `setPixel()` reads the segment first and skips writes that would not change
+     * it, so `isChanged()` only reports real changes and `getLitCount()` is kept up to date.
+     * This costs one driver buffer read per write. Off by default; `SBK_BarGroup` enables it
+     * for its bars.
+     *
+     * @param enable true to track changes.
+     * @return Reference to this instance.
+     */
+    SBK_BarMeter &setChangeTracking(bool enable)
+    {
+        _tracking = enable;
+        _litValid = false;
+        return *this;
     }
 
+    /**
+     * @brief Get the number of segments currently ON (logical state).
+     *
+     * With change tracking, the count is kept up to date by `setPixel()`, so this is normally
+     * free. Otherwise it is recounted from the driver buffer after any write. Segments hidden
+     * for the current flush (see `beginCommit()`) still count as lit.
+     *
+     * @return Number of lit segments.
+     */
+    uint8_t getLitCount()
+    {
+        if (!_litValid)
+        {
+            _litCount = 0;
+            for (uint8_t i = 0; i < _segsNum; ++i)
+                _litCount += getPixelState(i) || (i < SBK_BARDRIVE_MAX_SEGS && _hidden.getPixelState(i));
+            _litValid = true;
+        }
+        return _litCount;
+    }
+
+    /**
+     * @brief Returns true if the bar output changed since the last `clearChanged()`.
+     *
+     * Set by segment writes and by output modulation changes (blanking, software dimming,
+     * dithering). With change tracking (see `setChangeTracking()`), writing a segment to its
+     * current state does not count as a change.
+     */
+    bool isChanged() const { return _changed; }
+
+    /** @brief Acknowledge the pending changes reported by `isChanged()`. */
+    void clearChanged() { _changed = false; }
+
+    /**
+     * @brief Returns true if output modulation (blanking, dimming, dithering) is active.
+     *
+     * A modulated bar differs from one flush to the next, so it must keep being flushed
+     * even when its logical state does not change.
+     */
+    bool hasOutputFx() const { return _outputFx; }
+
     /**
      * @brief Get the current state of a bar segment (pixel).
      *
@@ -441,6 +949,7 @@ public:
     SBK_BarMeter &setSegmentOffset(uint8_t offset)
     {
         _segOffset = offset;
+        _mappingChanged();
         return *this;
     }
 
@@ -458,10 +967,53 @@ public:
     {
         _rowOffset = rowOffset;
         _colOffset = colOffset;
+        _mappingChanged();
         return *this;
     }
 
 private:
+    static const uint8_t NO_SEG = 0xFF;
+
+    inline void _mappingChanged()
+    {
+        _litValid = false;
+        _changed = true;
+    }
+
+    // Evenly spread 16-frame on/off patterns for duty 0/16 to 16/16 (bit n = frame n)
+    static inline uint16_t _ditherPattern(uint8_t duty)
+    {
+        static const uint16_t patterns[17] PROGMEM = {
+            0x0000, 0x8000, 0x8080, 0x8420, 0x8888, 0x9248, 0xA4A4, 0xAA54, 0xAAAA,
+            0xD5AA, 0xDADA, 0xEDB6, 0xEEEE, 0xFBDE, 0xFEFE, 0xFFFE, 0xFFFF};
+        return pgm_read_word(&patterns[duty]);
+    }
+
+    inline void _updateOutputFx()
+    {
+        const bool fx = _blanked || (_softBrightness < 15) || (_ditherSeg != NO_SEG);
+        // Leaving modulation needs one more flush to show the steady state
+        if (fx != _outputFx)
+            _changed = true;
+        _outputFx = fx;
+    }
+
+    inline void _writeLed(uint8_t segment, bool state)
+    {
+        uint8_t devIdx = _devIdx;
+        uint8_t rowIdx, colIdx;
+        _getMappedDevRowCol(segment, &devIdx, &rowIdx, &colIdx);
+        _driver->setLed(devIdx, rowIdx, colIdx, state);
+    }
+
+    inline void _hideIfLit(uint8_t segment)
+    {
+        if (segment >= SBK_BARDRIVE_MAX_SEGS || !getPixelState(segment))
+            return;
+        _writeLed(segment, false);
+        _hidden.setPixel(segment, true);
+    }
+
     void _initializePresetMapping(MatrixPreset matrixPreset)
     {
 
@@ -568,6 +1120,140 @@ private:
     uint8_t _rowsNum = 0;
     uint8_t _colsNum = 0;
     bool _userMappingIsProgmem = false;
+
+    // Change tracking (idle detection, power budget)
+    bool _tracking = false;
+    bool _changed = true;
+    bool _litValid = false;
+    uint8_t _litCount = 0;
+
+    // Output modulation (blanking / software dimming / fractional level dithering)
+    bool _outputFx = false;
+    bool _blanked = false;
+    uint8_t _softBrightness = 15;
+    uint8_t _ditherSeg = NO_SEG;
+    uint8_t _ditherDuty = 0;
+    uint8_t _ditherPhase = 0;
+    SBK_BarFrame<SBK_BARDRIVE_MAX_SEGS> _hidden;
+};
+
+// -----------------------------
+// SBK_BarMeterView
+// -----------------------------
+/**
+ * @class SBK_BarMeterView
+ * @brief Lightweight window over a range of segments of a parent bar meter.
+ *
+ * A view exposes a contiguous slice of a parent `SBK_BarMeter` (or another view) as an
+ * independent bar meter, optionally reversed. It holds no mapping state of its own: every
+ * pixel access is translated to the parent segment index and forwarded, so all views of a
+ * same parent share its driver buffer and are committed together by a single `show()`.
+ *
+ * Typical use is splitting one 28-segment BL28 into two 14-segment meters (left/right
+ * channels), each driven by its own `SBK_BarMeterAnimations`.
+ *
+ * @tparam BarMeterT Parent type (e.g., SBK_BarMeter<SBK_HT16K33>).
+ */
+template <typename BarMeterT>
+class SBK_BarMeterView
+{
+public:
+    /**
+     * @brief Construct a view over a range of the parent segments.
+     *
+     * @param parent     Reference to the parent bar meter.
+     * @param firstSeg   Index of the first parent segment covered by the view.
+     * @param segsNum    Number of segments in the view.
+     * @param direction  Optional view direction (FORWARD or REVERSE), relative to the parent. Default is FORWARD.
+     *
+     * ⚠️ The range is clamped to the parent segment count. A view starting beyond the parent is empty.
+     */
+    SBK_BarMeterView(BarMeterT &parent,
+                     uint8_t firstSeg,
+                     uint8_t segsNum,
+                     BarDirection direction = BarDirection::FORWARD)
+        : _parent(parent),
+          _firstSeg(firstSeg),
+          _segsNum(firstSeg < parent.getSegsNum() ? min(segsNum, (uint8_t)(parent.getSegsNum() - firstSeg)) : 0),
+          _direction(direction)
+    {
+    }
+
+    /**
+     * @brief Push the parent driver buffer to the physical display.
+     *
+     * Since views share the parent driver buffer, calling `show()` once per frame
+     * (on the parent or on any of its views) commits every view at once.
+     */
+    void show() { _parent.show(); }
+
+    /**
+     * @brief Clear all view segments, leaving the rest of the parent untouched.
+     */
+    void clear()
+    {
+        for (uint8_t i = 0; i < _segsNum; ++i)
+            setPixel(i, false);
+    }
+
+    /**
+     * @brief Set the view direction, relative to the parent.
+     * @param dir New direction (FORWARD or REVERSE).
+     */
+    void setDirection(BarDirection dir) { _direction = dir; }
+
+    /**
+     * @brief Get the view direction, relative to the parent.
+     * @return BarDirection enum.
+     */
+    BarDirection getDirection() const { return _direction; }
+
+    /**
+     * @brief Get the number of segments in the view.
+     * @return Number of segments.
+     */
+    uint8_t getSegsNum() const { return _segsNum; }
+
+    /**
+     * @brief Get the parent segment index of the first view segment.
+     * @return First parent segment index.
+     */
+    uint8_t getFirstSeg() const { return _firstSeg; }
+
+    /**
+     * @brief Set the on/off state of a view segment.
+     * @param segment Index of the view segment (0 to `getSegsNum() - 1`).
+     * @param state   true to turn the LED on, false to turn it off.
+     */
+    void setPixel(uint8_t segment, uint8_t state)
+    {
+        if (segment >= _segsNum)
+            return;
+        _parent.setPixel(_toParentSeg(segment), state);
+    }
+
+    /**
+     * @brief Get the current state of a view segment.
+     * @param segment Index of the view segment (0 to `getSegsNum() - 1`).
+     * @return 1 if the segment is ON, 0 if OFF or invalid.
+     */
+    uint8_t getPixelState(uint8_t segment) const
+    {
+        if (segment >= _segsNum)
+            return false;
+        return _parent.getPixelState(_toParentSeg(segment));
+    }
+
+private:
+    inline uint8_t _toParentSeg(uint8_t seg) const
+    {
+        return _firstSeg + ((_direction == BarDirection::REVERSE) ? (_segsNum - 1 - seg) : seg);
+    }
+
+    BarMeterT &_parent;
+    const uint8_t _firstSeg;
+    const uint8_t _segsNum;
+    BarDirection _direction;
 };
 
 // -----------------------------
@@ -729,7 +1415,30 @@ public:
 #endif
     }
 
-    ~SBK_BarDrive() { /* Nothing to clean up for now*/ }
+    /**
+     * @brief Construct a SBK_BarDrive from a compile-time layout.
+     *
+     * @param driver Pointer to the LED driver (e.g., SBK_MAX72xx or SBK_HT16K33).
+     * @param layout Layout built with an `SBK_BarLayout` factory.
+     *
+     * The driver is not queried. Without `SBK_BARDRIVE_WITH_ANIM`, a global bar built from a
+     * `constexpr` layout is constant-initialized and runs no constructor code at boot.
+     */
+#ifdef SBK_BARDRIVE_WITH_ANIM
+    SBK_BarDrive(DriverT *driver, const SBK_BarLayout &layout)
+        : _barMeter(driver, layout),
+          _barAnimations(_barMeter)
+    {
+        _barAnimations.setSegsNum(_barMeter.getSegsNum());
+    }
+#else
+    constexpr SBK_BarDrive(DriverT *driver, const SBK_BarLayout &layout)
+        : _barMeter(driver, layout)
+    {
+    }
+#endif
+
+    ~SBK_BarDrive() = default;
 
     /**
      * @brief Get the underlying SBK_BarMeter instance.
@@ -753,13 +1462,88 @@ public:
      *
      * Internally calls `_driver->show()` to update the display.
      */
-    void show() { _barMeter.show(); }
+    void show()
+    {
+        beginCommit();
+        _barMeter.getDriver()->show();
+        endCommit();
+    }
+
+    /**
+     * @brief Prepare the bar output for a driver flush (software blink, dimming, dithering).
+     *
+     * Must be paired with `endCommit()` right after the flush. `show()` does this automatically;
+     * call it directly when several bars share one driver `show()` (see `SBK_BarGroup`).
+     */
+    void beginCommit()
+    {
+        if (_blinkPeriod && !_blinkHw)
+            _barMeter.setBlanked((millis() - _blinkStart) % _blinkPeriod >= (uint32_t)(_blinkPeriod >> 1));
+        _barMeter.beginCommit();
+    }
+
+    /**
+     * @brief Restore the bar state after a driver flush started with `beginCommit()`.
+     */
+    void endCommit() { _barMeter.endCommit(); }
 
     /**
      * @brief Clear all bar segments.
      */
     void clear() { _barMeter.clear(); }
 
+    /**
+     * @brief Start blinking the bar, e.g. to flag an alarm state.
+     *
+     * If the driver exposes a hardware blink (`setBlinkRate(devIdx, rate)`, such as the
+     * HT16K33), the blink is offloaded to the chip: once the next `show()` is done, no CPU or
+     * bus time is spent on it. The period is rounded to the nearest hardware rate
+     * (500, 1000 or 2000 ms).
+     *
+     * Otherwise, the bar is blinked in software by blanking its lit segments on every other
+     * half period at flush time. The bar content is not redrawn, but the bar must keep being
+     * flushed regularly through this bar's `show()` or an `SBK_BarGroup`: a direct
+     * `driver.show()` skips the software blink.
+     *
+     * ⚠️ Hardware blink applies to the whole device(s) holding the bar, including any other
+     * bar wired to the same device. Pass `allowHardware = false` to blink this bar only.
+     *
+     * @param periodMs      Blink period in milliseconds (on + off). Default is 1000 ms.
+     * @param allowHardware Allow offloading to the driver hardware blink. Default is true.
+     * @return Reference to this instance.
+     */
+    SBK_BarDrive &blink(uint16_t periodMs = 1000, bool allowHardware = true)
+    {
+        noBlink();
+        if (periodMs < 2)
+            return *this;
+        _blinkPeriod = periodMs;
+        _blinkStart = millis();
+        if (allowHardware && SBK_DriverBlink<DriverT>::supported)
+            _blinkHw = _setHardwareBlink(periodMs < 750 ? 1 : (periodMs < 1500 ? 2 : 3));
+        return *this;
+    }
+
+    /**
+     * @brief Stop blinking and show the bar steadily.
+     * @return Reference to this instance.
+     */
+    SBK_BarDrive &noBlink()
+    {
+        if (_blinkHw)
+            _setHardwareBlink(0);
+        _blinkHw = false;
+        _blinkPeriod = 0;
+        _barMeter.setBlanked(false);
+        return *this;
+    }
+
+    /** @brief Returns true if the bar is blinking. */
+    bool isBlinking() const { return _blinkPeriod != 0; }
+
+    /** @brief Returns true if the blink is offloaded to the driver hardware. */
+    bool isHardwareBlink() const { return _blinkHw; }
+
     /**
      * @brief Set the bar fill direction.
      * @param dir New direction (FORWARD or REVERSE).
@@ -819,6 +1603,25 @@ public:
      */
     uint8_t getPixelState(uint8_t segment) { return _barMeter.getPixelState(segment); }
 
+    /**
+     * @brief Display a level with sub-segment resolution (dithered top segment).
+     * @param value    Level to display, from 0 to `maxValue`.
+     * @param maxValue Value of a fully lit bar. Default is 1023 (10-bit ADC).
+     */
+    void setFillLevel(uint16_t value, uint16_t maxValue = 1023) { _barMeter.setFillLevel(value, maxValue); }
+
+    /**
+     * @brief Set the software brightness of this bar only.
+     * @param level Brightness level, 0 (1/16 duty) to 15 (full, no modulation).
+     */
+    void setSoftBrightness(uint8_t level) { _barMeter.setSoftBrightness(level); }
+
+    /**
+     * @brief Get the software brightness of this bar.
+     * @return Brightness level (0–15).
+     */
+    uint8_t getSoftBrightness() { return _barMeter.getSoftBrightness(); }
+
     /**
      * @brief Apply a segment-wise offset (shifts segment index before mapping to row/col).
      * @param offset Number of segments to skip.
@@ -851,7 +1654,20 @@ public:
     }
 
 private:
+    bool _setHardwareBlink(uint8_t rate)
+    {
+        const uint8_t devices = _barMeter.getDevicesMask();
+        bool done = false;
+        for (uint8_t d = 0; d < 8; ++d)
+            if (devices & (1 << d))
+                done = SBK_DriverBlink<DriverT>::set(_barMeter.getDriver(), d, rate);
+        return done;
+    }
+
     SBK_BarMeter<DriverT> _barMeter;
+    uint32_t _blinkStart = 0;
+    uint16_t _blinkPeriod = 0;
+    bool _blinkHw = false;
 #ifdef SBK_BARDRIVE_WITH_ANIM
     /**
      * @brief Get the animation controller instance (if enabled).
@@ -860,3 +1676,99 @@ private:
     SBK_BarMeterAnimations<SBK_BarMeter<DriverT>> _barAnimations;
 #endif
 };
+
+// -----------------------------
+// SBK_BarDriveView wrapper
+// -----------------------------
+/**
+ * @class SBK_BarDriveView
+ * @brief Sub-bar of an SBK_BarDrive with its own optional animation controller.
+ *
+ * Wraps an `SBK_BarMeterView` over the parent bar meter of an `SBK_BarDrive` and, if enabled,
+ * attaches an independent `SBK_BarMeterAnimations` to it. Several views can split one physical
+ * bar meter into independent meters, e.g. two 14-segment channels on a single BL28:
+ *
+ * @code
+ * SBK_BarDrive<SBK_HT16K33> bar(&driver, 0, MatrixPreset::BL28_3005SK);
+ * SBK_BarDriveView<SBK_HT16K33> left(bar, 0, 14, BarDirection::REVERSE);
+ * SBK_BarDriveView<SBK_HT16K33> right(bar, 14, 14);
+ * @endcode
+ *
+ * @note The parent animations should be left stopped while its views are animated.
+ */
+template <typename DriverT>
+class SBK_BarDriveView
+{
+public:
+    /**
+     * @brief Construct a view over a range of the parent bar segments.
+     *
+     * @param parent     Reference to the parent SBK_BarDrive.
+     * @param firstSeg   Index of the first parent segment covered by the view.
+     * @param segsNum    Number of segments in the view.
+     * @param direction  Optional view direction (FORWARD or REVERSE), relative to the parent. Default is FORWARD.
+     */
+    SBK_BarDriveView(SBK_BarDrive<DriverT> &parent,
+                     uint8_t firstSeg,
+                     uint8_t segsNum,
+                     BarDirection direction = BarDirection::FORWARD)
+        : _view(parent.barmeter(), firstSeg, segsNum, direction)
+#ifdef SBK_BARDRIVE_WITH_ANIM
+          ,
+          _barAnimations(_view)
+#endif
+    {
+#ifdef SBK_BARDRIVE_WITH_ANIM
+        _barAnimations.setSegsNum(_view.getSegsNum());
+#endif
+    }
+
+    /**
+     * @brief Get the underlying SBK_BarMeterView instance.
+     * @return Reference to the SBK_BarMeterView object.
+     */
+    SBK_BarMeterView<SBK_BarMeter<DriverT>> &barmeter() { return _view; }
+#ifdef SBK_BARDRIVE_WITH_ANIM
+    /**
+     * @brief Get the animation controller instance (if enabled).
+     * @return Reference to SBK_BarMeterAnimations.
+     */
+    SBK_BarMeterAnimations<SBK_BarMeterView<SBK_BarMeter<DriverT>>> &animations() { return _barAnimations; }
+#endif
+
+    /** @brief Push the shared driver buffer to the physical display (commits all views). */
+    void show() { _view.show(); }
+
+    /** @brief Clear the view segments only. */
+    void clear() { _view.clear(); }
+
+    /** @brief Set the view direction, relative to the parent. */
+    void setDirection(BarDirection dir) { _view.setDirection(dir); }
+
+    /** @brief Get the view direction, relative to the parent. */
+    BarDirection getDirection() { return _view.getDirection(); }
+
+    /** @brief Get the number of segments in the view. */
+    uint8_t getSegsNum() { return _view.getSegsNum(); }
+
+    /** @brief Set the on/off state of a view segment. */
+    void setPixel(uint8_t segment, uint8_t state) { _view.setPixel(segment, state); }
+
+    /** @brief Get the current state of a view segment. */
+    uint8_t getPixelState(uint8_t segment) { return _view.getPixelState(segment); }
+
+private:
+    SBK_BarMeterView<SBK_BarMeter<DriverT>> _view;
+#ifdef SBK_BARDRIVE_WITH_ANIM
+    SBK_BarMeterAnimations<SBK_BarMeterView<SBK_BarMeter<DriverT>>> _barAnimations;
+#endif
+};
+
+#include "SBK_BarGroup.h"
+#include "SBK_BarFrameExchange.h"
+#include "SBK_BarBatch.h"
+#include "SBK_BarDriverRef.h"
+#ifdef SBK_BARDRIVE_WITH_ANIM
+#include "SBK_BarBroadcast.h"
+#include "SBK_BarDisplayService.h"
+#endif
@@ -0,0 +1,240 @@
+/**
+ * @file SBK_BarDriverRef.h
+ * @brief Type-erased driver backend: one copy of the bar and animation code for every driver type.
+ *
+ * `SBK_BarMeter<DriverT>`, `SBK_BarDrive<DriverT>` and their animations are instantiated once per
+ * driver type, so a sketch mixing MAX72xx and HT16K33 bars carries two copies of the library.
+ * `SBK_BarDriverRef` wraps any driver behind a small function table: use `SBK_BarDrive<SBK_BarDriverRef>`
+ * for every bar, and only the few table thunks are compiled per driver type.
+ *
+ * LED traffic goes through a one-device frame cache (16 rows x 16 columns): a row is fetched with
+ * one table call the first time it is touched, and all the changed rows of the device are written
+ * back with one table call by `show()`, `flush()` or when another device is touched. Bars mapped
+ * column-major, touching a different row on every segment, are served from the cache too.
+ * The cache stays valid across `show()`: a steady bar costs no driver reads at all.
+ *
+ * @code
+ * SBK_MAX72xxHard max(CS_PIN, 1);
+ * SBK_HT16K33 ht(1);
+ * SBK_BarDriverRef maxRef(&max);
+ * SBK_BarDriverRef htRef(&ht);
+ * SBK_BarDrive<SBK_BarDriverRef> bar1(&maxRef, 0, MatrixPreset::BL28_3005SK);
+ * SBK_BarDrive<SBK_BarDriverRef> bar2(&htRef, 0, MatrixPreset::BL28_3005SK);
+ * @endcode
+ *
+ * All bars on one physical driver must go through the same `SBK_BarDriverRef`: call `invalidate()`
+ * after writing to the wrapped driver directly. Rows and columns are limited to 16.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "SBK_DriverTraits.h"
+
+/**
+ * @struct SBK_BarDriverOps
+ * @brief Function table of a type-erased driver.
+ */
+struct SBK_BarDriverOps
+{
+    uint8_t (*devsNum)(const void *drv);
+    uint8_t (*maxRows)(const void *drv, uint8_t devIdx);
+    uint8_t (*maxColumns)(const void *drv);
+    uint8_t (*maxSegments)(const void *drv, uint8_t devIdx);
+    uint16_t (*readRow)(const void *drv, uint8_t devIdx, uint8_t row);
+    void (*writeRows)(void *drv, uint8_t devIdx, const uint16_t *bits, const uint16_t *mask, uint16_t rows);
+    void (*show)(void *drv);
+    void (*setBrightness)(void *drv, uint8_t devIdx, uint8_t brightness);
+    void (*begin)(void *drv);
+    bool (*setBlinkRate)(void *drv, uint8_t devIdx, uint8_t rate);
+    bool (*shutdown)(void *drv, uint8_t devIdx, bool down);
+};
+
+/**
+ * @struct SBK_BarDriverOpsFor
+ * @brief Function table thunks for a driver type. The only code compiled per driver type.
+ */
+template <typename DriverT>
+struct SBK_BarDriverOpsFor
+{
+    static uint8_t devsNum(const void *d) { return ((const DriverT *)d)->devsNum(); }
+    static uint8_t maxRows(const void *d, uint8_t dev) { return ((const DriverT *)d)->maxRows(dev); }
+    static uint8_t maxColumns(const void *d) { return ((const DriverT *)d)->maxColumns(); }
+    static uint8_t maxSegments(const void *d, uint8_t dev) { return ((const DriverT *)d)->maxSegments(dev); }
+
+    static uint16_t readRow(const void *d, uint8_t dev, uint8_t row)
+    {
+        const DriverT *drv = (const DriverT *)d;
+        const uint8_t cols = min(drv->maxColumns(), (uint8_t)16);
+        uint16_t bits = 0;
+        for (uint8_t c = 0; c < cols; ++c)
+            if (drv->getLed(dev, row, c))
+                bits |= (uint16_t)(1U << c);
+        return bits;
+    }
+
+    // Write the masked bits of every row flagged in `rows`
+    static void writeRows(void *d, uint8_t dev, const uint16_t *bits, const uint16_t *mask, uint16_t rows)
+    {
+        DriverT *drv = (DriverT *)d;
+        for (uint8_t r = 0; rows; ++r, rows >>= 1)
+        {
+            if (!(rows & 1))
+                continue;
+            uint16_t m = mask[r], b = bits[r];
+            for (uint8_t c = 0; m; ++c, m >>= 1, b >>= 1)
+                if (m & 1)
+                    drv->setLed(dev, r, c, b & 1);
+        }
+    }
+
+    static void show(void *d) { ((DriverT *)d)->show(); }
+    static void setBrightness(void *d, uint8_t dev, uint8_t b) { ((DriverT *)d)->setBrightness(dev, b); }
+    static void begin(void *d) { ((DriverT *)d)->begin(); }
+    static bool setBlinkRate(void *d, uint8_t dev, uint8_t rate) { return SBK_DriverBlink<DriverT>::set((DriverT *)d, dev, rate); }
+    static bool shutdown(void *d, uint8_t dev, bool down) { return SBK_DriverPower<DriverT>::set((DriverT *)d, dev, down); }
+
+    static const SBK_BarDriverOps ops;
+};
+
+template <typename DriverT>
+const SBK_BarDriverOps SBK_BarDriverOpsFor<DriverT>::ops = {
+    &SBK_BarDriverOpsFor<DriverT>::devsNum,
+    &SBK_BarDriverOpsFor<DriverT>::maxRows,
+    &SBK_BarDriverOpsFor<DriverT>::maxColumns,
+    &SBK_BarDriverOpsFor<DriverT>::maxSegments,
+    &SBK_BarDriverOpsFor<DriverT>::readRow,
+    &SBK_BarDriverOpsFor<DriverT>::writeRows,
+    &SBK_BarDriverOpsFor<DriverT>::show,
+    &SBK_BarDriverOpsFor<DriverT>::setBrightness,
+    &SBK_BarDriverOpsFor<DriverT>::begin,
+    &SBK_BarDriverOpsFor<DriverT>::setBlinkRate,
+    &SBK_BarDriverOpsFor<DriverT>::shutdown};
+
+/**
+ * @class SBK_BarDriverRef
+ * @brief Type-erased driver exposing the SBK driver API through a function table and a frame cache.
+ *
+ * Hardware blink and shutdown requests are forwarded and report false when the wrapped driver
+ * lacks them, so bars fall back to their software behavior.
+ */
+class SBK_BarDriverRef
+{
+public:
+    /**
+     * @brief Wrap a driver.
+     * @param driver Driver instance. Must outlive the reference.
+     */
+    template <typename DriverT>
+    explicit SBK_BarDriverRef(DriverT *driver) : _drv(driver), _ops(&SBK_BarDriverOpsFor<DriverT>::ops) {}
+
+    uint8_t devsNum() const { return _ops->devsNum(_drv); }
+    uint8_t maxRows(uint8_t devIdx) const { return _ops->maxRows(_drv, devIdx); }
+    uint8_t maxColumns() const { return _ops->maxColumns(_drv); }
+    uint8_t maxSegments(uint8_t devIdx) const { return _ops->maxSegments(_drv, devIdx); }
+
+    void begin()
+    {
+        flush();
+        _invalidate();
+        _ops->begin(_drv);
+    }
+
+    /** @brief Set a LED through the frame cache. */
+    void setLed(uint8_t devIdx, uint8_t row, uint8_t column, bool state)
+    {
+        if (column >= 16 || row >= CACHE_ROWS)
+            return;
+        _selectRow(devIdx, row);
+        const uint16_t bit = (uint16_t)(1U << column);
+        if (((_bits[row] & bit) != 0) == state)
+            return;
+        _bits[row] ^= bit;
+        _dirty[row] ^= bit; // toggling back to the driver state cancels the pending write
+        if (_dirty[row])
+            _dirtyRows |= (uint16_t)(1U << row);
+        else
+            _dirtyRows &= (uint16_t)~(1U << row);
+    }
+
+    /** @brief Get a LED through the frame cache. */
+    bool getLed(uint8_t devIdx, uint8_t row, uint8_t column) const
+    {
+        if (column >= 16 || row >= CACHE_ROWS)
+            return false;
+        _selectRow(devIdx, row);
+        return (_bits[row] >> column) & 1;
+    }
+
+    /** @brief Write the changed rows of the cached device back to the driver, in one table call. */
+    void flush() const
+    {
+        if (!_dirtyRows)
+            return;
+        _ops->writeRows(_drv, _dev, _bits, _dirty, _dirtyRows);
+        for (uint8_t r = 0; _dirtyRows; ++r, _dirtyRows >>= 1)
+            _dirty[r] = 0;
+    }
+
+    /** @brief Write back the cache and push the driver buffer to the display. The cache stays valid. */
+    void show()
+    {
+        flush();
+        _ops->show(_drv);
+    }
+
+    /** @brief Drop the cache after the wrapped driver was written directly. Pending writes are flushed first. */
+    void invalidate()
+    {
+        flush();
+        _invalidate();
+    }
+
+    void setBrightness(uint8_t devIdx, uint8_t brightness) { _ops->setBrightness(_drv, devIdx, brightness); }
+
+    /** @brief Forward a hardware blink request. Returns false if the driver has none. */
+    bool setBlinkRate(uint8_t devIdx, uint8_t rate) { return _ops->setBlinkRate(_drv, devIdx, rate); }
+
+    /** @brief Forward a power-down request. Returns false if the driver has none. */
+    bool shutdown(uint8_t devIdx, bool down) { return _ops->shutdown(_drv, devIdx, down); }
+
+private:
+    static const uint8_t CACHE_ROWS = 16;
+
+    // Make `row` of `devIdx` cached: switching device writes the previous one back, rows load on first use
+    void _selectRow(uint8_t devIdx, uint8_t row) const
+    {
+        if (devIdx != _dev)
+        {
+            flush();
+            _dev = devIdx;
+            _validRows = 0;
+        }
+        const uint16_t bit = (uint16_t)(1U << row);
+        if (_validRows & bit)
+            return;
+        _bits[row] = _ops->readRow(_drv, devIdx, row);
+        _validRows |= bit;
+    }
+
+    void _invalidate() const { _validRows = 0; }
+
+    void *_drv;
+    const SBK_BarDriverOps *_ops;
+
+    // One-device frame cache
+    mutable uint16_t _bits[CACHE_ROWS] = {};  // LED states of each row
+    mutable uint16_t _dirty[CACHE_ROWS] = {}; // bits not yet written to the driver
+    mutable uint16_t _validRows = 0;          // rows loaded from the driver
+    mutable uint16_t _dirtyRows = 0;          // rows with pending writes
+    mutable uint8_t _dev = 0;
+};
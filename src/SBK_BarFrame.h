@@ -0,0 +1,153 @@
+/**
+ * @file SBK_BarFrame.h
+ * @brief Packed bitset frame usable as an off-screen bar meter render target.
+ *
+ * This file defines the `SBK_BarFrame` template class, a fixed-capacity packed bitset holding
+ * one ON/OFF state per bar segment. It exposes the same pixel interface as `SBK_BarMeter`
+ * (`setPixel()`, `getPixelState()`, `clear()`, `getSegsNum()`, `show()`), so animations can
+ * render into it exactly as they would into a physical bar, and it offers word-wise access
+ * for bulk operations (diffing, counting, copying) on whole frames.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @class SBK_BarFrame
+ * @brief Off-screen bar meter frame stored as a packed bitset.
+ *
+ * Segment `i` is stored in bit `i % 32` of word `i / 32`. Bits beyond `getSegsNum()`
+ * are always kept cleared so whole-word operations never see stray segments.
+ *
+ * @tparam MAX_SEGS Maximum number of segments the frame can hold (1–255).
+ */
+template <uint8_t MAX_SEGS = 32>
+class SBK_BarFrame
+{
+public:
+    /** @brief Number of 32-bit words used to store the frame. */
+    static const uint8_t WORDS = (MAX_SEGS + 31) / 32;
+
+    /**
+     * @brief Construct an empty frame.
+     * @param segsNum Number of active segments. Clamped to MAX_SEGS. Default is MAX_SEGS.
+     */
+    constexpr explicit SBK_BarFrame(uint8_t segsNum = MAX_SEGS)
+        : _bits(),
+          _segsNum(segsNum > MAX_SEGS ? MAX_SEGS : segsNum)
+    {
+    }
+
+    /** @brief No-op, an off-screen frame has nothing to flush. */
+    void show() {}
+
+    /** @brief Turn all segments off. */
+    void clear()
+    {
+        for (uint8_t w = 0; w < WORDS; ++w)
+            _bits[w] = 0;
+    }
+
+    /**
+     * @brief Set the number of active segments.
+     * @param n Number of segments. Clamped to MAX_SEGS. Segments beyond `n` are cleared.
+     */
+    void setSegsNum(uint8_t n)
+    {
+        _segsNum = n > MAX_SEGS ? MAX_SEGS : n;
+        for (uint8_t w = 0; w < WORDS; ++w)
+            _bits[w] &= _wordMask(w);
+    }
+
+    /**
+     * @brief Get the number of active segments.
+     * @return Number of segments.
+     */
+    uint8_t getSegsNum() const { return _segsNum; }
+
+    /**
+     * @brief Set the on/off state of a segment.
+     * @param segment Index of the segment (0 to `getSegsNum() - 1`).
+     * @param state   true to turn the segment on, false to turn it off.
+     */
+    void setPixel(uint8_t segment, uint8_t state)
+    {
+        if (segment >= _segsNum)
+            return;
+        if (state)
+            _bits[segment >> 5] |= (1UL << (segment & 31));
+        else
+            _bits[segment >> 5] &= ~(1UL << (segment & 31));
+    }
+
+    /**
+     * @brief Get the state of a segment.
+     * @param segment Index of the segment (0 to `getSegsNum() - 1`).
+     * @return 1 if the segment is ON, 0 if OFF or invalid.
+     */
+    uint8_t getPixelState(uint8_t segment) const
+    {
+        if (segment >= _segsNum)
+            return false;
+        return (_bits[segment >> 5] >> (segment & 31)) & 1UL;
+    }
+
+    /**
+     * @brief Get a storage word.
+     * @param w Word index (0 to WORDS - 1).
+     * @return Packed segments `w * 32` to `w * 32 + 31`.
+     */
+    uint32_t word(uint8_t w) const { return _bits[w]; }
+
+    /**
+     * @brief Overwrite a storage word. Bits beyond `getSegsNum()` are masked out.
+     * @param w    Word index (0 to WORDS - 1).
+     * @param bits New packed segment states.
+     */
+    void setWord(uint8_t w, uint32_t bits) { _bits[w] = bits & _wordMask(w); }
+
+    /**
+     * @brief Count the segments currently ON.
+     * @return Number of lit segments.
+     */
+    uint16_t count() const
+    {
+        uint16_t n = 0;
+        for (uint8_t w = 0; w < WORDS; ++w)
+            n += __builtin_popcountl(_bits[w]);
+        return n;
+    }
+
+    /** @brief Returns true if no segment is ON. */
+    bool isEmpty() const
+    {
+        for (uint8_t w = 0; w < WORDS; ++w)
+            if (_bits[w])
+                return false;
+        return true;
+    }
+
+protected:
+    inline uint32_t _wordMask(uint8_t w) const
+    {
+        const uint16_t first = (uint16_t)w * 32;
+        if (_segsNum <= first)
+            return 0;
+        if (_segsNum - first >= 32)
+            return 0xFFFFFFFFUL;
+        return (1UL << (_segsNum - first)) - 1;
+    }
+
+    uint32_t _bits[WORDS];
+    uint8_t _segsNum;
+};
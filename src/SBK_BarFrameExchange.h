@@ -0,0 +1,250 @@
+/**
+ * @file SBK_BarFrameExchange.h
+ * @brief Lock-free frame handoff between bar rendering and driver transmission (dual-core split).
+ *
+ * This file defines the `SBK_BarTripleBuffer` template class, a single-producer/single-consumer
+ * latest-frame-wins exchange, and the `SBK_BarSplitDriver` template class, a driver stand-in
+ * bars render into. `show()` on the render side publishes the device image without touching the
+ * bus; `transmit()` on the other side (another core or thread) takes the newest complete frame
+ * and writes only its changed LEDs to the real driver. Rendering never waits for bus I/O, and an
+ * intermediate frame is simply skipped when transmission is slower than rendering.
+ *
+ * Requires `<atomic>` (ESP32, ARM cores, host builds); on targets without it this file defines nothing.
+ *
+ * @code
+ * SBK_HT16K33 driver(2);
+ * SBK_BarSplitDriver<SBK_HT16K33> split(&driver);
+ * SBK_BarDrive<SBK_BarSplitDriver<SBK_HT16K33>> bar(&split, 0, MatrixPreset::BL28_3005SK);
+ *
+ * void transmitTask(void *) {  // pinned to core 0
+ *     for (;;) { split.transmit(); vTaskDelay(1); }
+ * }
+ *
+ * void setup() {
+ *     driver.begin();
+ *     xTaskCreatePinnedToCore(transmitTask, "barTx", 4096, nullptr, 1, nullptr, 0);
+ * }
+ *
+ * void loop() {  // core 1
+ *     bar.animations().update();
+ *     bar.show(); // publishes the frame, never blocks on the bus
+ * }
+ * @endcode
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+#if defined(__has_include)
+#if __has_include(<atomic>)
+/**
+ * @def SBK_BARDRIVE_HAS_ATOMIC
+ * @brief Defined when `<atomic>` is available and the frame exchange classes are compiled.
+ */
+#define SBK_BARDRIVE_HAS_ATOMIC
+#endif
+#endif
+
+#ifdef SBK_BARDRIVE_HAS_ATOMIC
+
+// Arduino cores defining min/max as macros would break the standard headers
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#include <atomic>
+#pragma pop_macro("max")
+#pragma pop_macro("min")
+#include <string.h>
+
+/**
+ * @class SBK_BarTripleBuffer
+ * @brief Lock-free single-producer/single-consumer exchange of the latest complete value.
+ *
+ * The producer fills `back()` then calls `publish()`; the consumer calls `acquire()` and reads
+ * `front()`. Neither side ever waits: the three buffers are swapped through one atomic index.
+ *
+ * @tparam T Frame type (trivially copyable).
+ */
+template <typename T>
+class SBK_BarTripleBuffer
+{
+public:
+    SBK_BarTripleBuffer() : _state(1), _back(0), _front(2) {}
+
+    /** @brief Producer: buffer to fill. Its content is an older frame after `publish()`. */
+    T &back() { return _buf[_back]; }
+
+    /** @brief Producer: hand the filled back buffer over, replacing any frame not yet acquired. */
+    void publish()
+    {
+        _back = _state.exchange((uint8_t)(_back | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    /**
+     * @brief Consumer: take the latest published frame.
+     * @return true if a new frame is available in `front()`, false if nothing was published since.
+     */
+    bool acquire()
+    {
+        if (!(_state.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        _front = _state.exchange(_front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    /** @brief Consumer: latest acquired frame. */
+    const T &front() const { return _buf[_front]; }
+
+private:
+    static const uint8_t INDEX = 0x03;
+    static const uint8_t FRESH = 0x04;
+
+    T _buf[3];
+    std::atomic<uint8_t> _state; // middle buffer index | FRESH
+    uint8_t _back;               // producer owned
+    uint8_t _front;              // consumer owned
+};
+
+/**
+ * @struct SBK_BarDevFrame
+ * @brief Device image exchanged by `SBK_BarSplitDriver`: one column bitmask per row, and brightness.
+ */
+template <uint8_t MAX_DEVS, uint8_t MAX_ROWS>
+struct SBK_BarDevFrame
+{
+    uint16_t rows[MAX_DEVS][MAX_ROWS];
+    uint8_t brightness[MAX_DEVS]; ///< 0xFF = not set
+};
+
+/**
+ * @class SBK_BarSplitDriver
+ * @brief Driver stand-in decoupling bar rendering from the real driver bus transfers.
+ *
+ * Exposes the mandatory driver API, so `SBK_BarDrive`, views and groups render into it
+ * unchanged. Call `show()` (through the bars) on the render side and `transmit()` on the
+ * transmit side. Call the real driver `begin()` on the transmit side, before the first `transmit()`.
+ *
+ * @tparam DriverT  Real driver type.
+ * @tparam MAX_DEVS Maximum number of devices mirrored. Default is 4.
+ * @tparam MAX_ROWS Maximum number of rows per device. Default is 16. Up to 16 columns are mirrored.
+ */
+template <typename DriverT, uint8_t MAX_DEVS = 4, uint8_t MAX_ROWS = 16>
+class SBK_BarSplitDriver
+{
+public:
+    typedef SBK_BarDevFrame<MAX_DEVS, MAX_ROWS> Frame;
+
+    /**
+     * @brief Construct a split driver over a real driver.
+     * @param driver Real driver, written by `transmit()` only.
+     */
+    explicit SBK_BarSplitDriver(DriverT *driver) : _driver(driver)
+    {
+        memset(&_work, 0, sizeof(_work));
+        memset(_work.brightness, 0xFF, sizeof(_work.brightness));
+        _sent = _work;
+    }
+
+    uint8_t devsNum() const { return min(_driver->devsNum(), MAX_DEVS); }
+    uint8_t maxRows(uint8_t devIdx) const { return min(_driver->maxRows(devIdx), MAX_ROWS); }
+    uint8_t maxColumns() const { return min(_driver->maxColumns(), (uint8_t)16); }
+    uint8_t maxSegments(uint8_t devIdx) const { return maxRows(devIdx) * maxColumns(); }
+
+    /** @brief Render side: nothing to do, the real driver is started on the transmit side. */
+    void begin() {}
+
+    /** @brief Render side: set a LED in the working image. */
+    void setLed(uint8_t devIdx, uint8_t row, uint8_t column, bool state)
+    {
+        if (devIdx >= MAX_DEVS || row >= MAX_ROWS || column >= 16)
+            return;
+        if (state)
+            _work.rows[devIdx][row] |= (uint16_t)(1U << column);
+        else
+            _work.rows[devIdx][row] &= (uint16_t)~(1U << column);
+    }
+
+    /** @brief Render side: get a LED from the working image. */
+    bool getLed(uint8_t devIdx, uint8_t row, uint8_t column) const
+    {
+        if (devIdx >= MAX_DEVS || row >= MAX_ROWS || column >= 16)
+            return false;
+        return (_work.rows[devIdx][row] >> column) & 1;
+    }
+
+    /** @brief Render side: set a device brightness, applied by the next transmitted frame. */
+    void setBrightness(uint8_t devIdx, uint8_t brightness)
+    {
+        if (devIdx < MAX_DEVS)
+            _work.brightness[devIdx] = brightness;
+    }
+
+    /** @brief Render side: publish the working image as the latest complete frame. Never blocks. */
+    void show()
+    {
+        _exchange.back() = _work;
+        _exchange.publish();
+    }
+
+    /**
+     * @brief Transmit side: write the latest frame to the real driver, if a new one was published.
+     *
+     * Only LEDs and brightness that changed since the previous transmitted frame are written.
+     *
+     * @return true if a frame was transmitted.
+     */
+    bool transmit()
+    {
+        if (!_exchange.acquire())
+            return false;
+        const Frame &f = _exchange.front();
+        const uint8_t devs = devsNum();
+        const uint8_t cols = maxColumns();
+        for (uint8_t d = 0; d < devs; ++d)
+        {
+            if (f.brightness[d] != _sent.brightness[d])
+            {
+                _driver->setBrightness(d, f.brightness[d]);
+                _sent.brightness[d] = f.brightness[d];
+            }
+            const uint8_t rows = maxRows(d);
+            for (uint8_t r = 0; r < rows; ++r)
+            {
+                uint16_t diff = f.rows[d][r] ^ _sent.rows[d][r];
+                for (uint8_t c = 0; diff && c < cols; ++c, diff >>= 1)
+                    if (diff & 1)
+                        _driver->setLed(d, r, c, (f.rows[d][r] >> c) & 1);
+                _sent.rows[d][r] = f.rows[d][r];
+            }
+        }
+        _driver->show();
+        ++_transmitted;
+        return true;
+    }
+
+    /** @brief Transmit side: number of frames transmitted. */
+    uint32_t getTransmittedFrames() const { return _transmitted; }
+
+    /** @brief Get the real driver. */
+    DriverT *getDriver() { return _driver; }
+
+private:
+    DriverT *_driver;
+    Frame _work;                        // render side
+    Frame _sent;                        // transmit side
+    SBK_BarTripleBuffer<Frame> _exchange;
+    uint32_t _transmitted = 0;
+};
+
+#endif // SBK_BARDRIVE_HAS_ATOMIC
@@ -0,0 +1,441 @@
+/**
+ * @file SBK_BarGroup.h
+ * @brief Group of bars sharing one driver: single flush, idle detection and device power-down.
+ *
+ * This file defines the `SBK_BarGroup` template class. A group drives several `SBK_BarDrive`
+ * instances wired to the same driver: it updates their animations, flushes the driver once
+ * for all of them, and skips the flush entirely when no bar changed. Devices whose bars are
+ * unchanged for a configurable time, or optionally all dark, are put in the driver shutdown
+ * mode and woken up transparently on the next change. An optional power budget caps the number of
+ * segments lit per device and in total, enforced at flush time.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+#include "SBK_DriverTraits.h"
+
+/**
+ * @enum PowerBudgetAction
+ * @brief What an `SBK_BarGroup` does when its power budget is exceeded.
+ */
+enum class PowerBudgetAction : uint8_t
+{
+    CLAMP = 0, ///< Hide the topmost lit segments of each bar until the budget is met.
+    DIM = 1    ///< Lower the device brightness in proportion to the overflow.
+};
+
+/**
+ * @struct SBK_BarGroupStats
+ * @brief Flush and power statistics of an `SBK_BarGroup`.
+ */
+struct SBK_BarGroupStats
+{
+    uint32_t flushes = 0;        ///< Driver flushes performed.
+    uint32_t skippedFlushes = 0; ///< `show()` calls skipped because nothing changed.
+    uint32_t powerDowns = 0;     ///< Device power-downs issued.
+    uint32_t poweredDownMs = 0;  ///< Accumulated device power-down time, in device-milliseconds.
+    uint32_t overBudget = 0;     ///< Flushes on which the power budget had to be enforced.
+};
+
+/**
+ * @class SBK_BarGroup
+ * @brief Several bars on one driver, flushed together with idle power management.
+ *
+ * @code
+ * SBK_BarGroup<SBK_HT16K33> panel(&driver);
+ * panel.addBar(bar1);
+ * panel.addBar(bar2);
+ * panel.setIdleTimeout(60000); // power down devices static for one minute
+ *
+ * void loop() {
+ *     panel.update();
+ *     panel.show();
+ * }
+ * @endcode
+ *
+ * Power-down requires a driver exposing `shutdown(devIdx, status)`, detected at compile time.
+ * Without it, the group still skips flushes while nothing changes.
+ *
+ * @note The group assumes it owns the devices holding its bars: a device is powered down
+ * based on the group bars only.
+ *
+ * @tparam DriverT  Driver type shared by all the bars.
+ * @tparam MAX_BARS Maximum number of bars in the group.
+ */
+template <typename DriverT, uint8_t MAX_BARS = 8>
+class SBK_BarGroup
+{
+public:
+    /** @brief Bar type handled by the group. */
+    typedef SBK_BarDrive<DriverT> BarT;
+
+    /**
+     * @brief Construct an empty group.
+     * @param driver Pointer to the LED driver shared by the bars.
+     */
+    explicit SBK_BarGroup(DriverT *driver) : _driver(driver) {}
+
+    /**
+     * @brief Add a bar to the group.
+     * @param bar Reference to a bar wired to the group driver.
+     * @return true if the bar was added, false if MAX_BARS is reached or the driver differs.
+     */
+    bool addBar(BarT &bar)
+    {
+        if (_barsNum >= MAX_BARS || bar.barmeter().getDriver() != _driver)
+            return false;
+        bar.barmeter().setChangeTracking(true);
+        _bars[_barsNum] = &bar;
+        _barDevices[_barsNum] = bar.barmeter().getDevicesMask();
+        _devices |= _barDevices[_barsNum];
+        ++_barsNum;
+        _forceFlush = true;
+        return true;
+    }
+
+    /** @brief Get the number of bars in the group. */
+    uint8_t getBarsNum() const { return _barsNum; }
+
+    /**
+     * @brief Set the time after which a device whose bars did not change is powered down.
+     * @param ms Idle time in milliseconds. 0 disables static power-down (default).
+     * @return Reference to this instance.
+     */
+    SBK_BarGroup &setIdleTimeout(uint32_t ms)
+    {
+        _idleTimeout = ms;
+        return *this;
+    }
+
+    /**
+     * @brief Enable or disable powering down devices whose bars are all dark.
+     *
+     * Off by default: a device is powered down as a whole, so only enable it when the group
+     * bars are the only ones on their devices.
+     *
+     * @param enable true to power down dark devices, false to keep them running (default).
+     * @return Reference to this instance.
+     */
+    SBK_BarGroup &setPowerDownWhenDark(bool enable)
+    {
+        _downWhenDark = enable;
+        return *this;
+    }
+
+    /**
+     * @brief Set a power budget, as a maximum number of lit segments.
+     *
+     * The budget is checked on each flush from the bars lit counters, so it costs a few
+     * additions per bar while under budget. A bar split over several devices counts fully
+     * against each of them.
+     *
+     * @param maxLitPerDevice Maximum lit segments per device. 0 for no per-device limit.
+     * @param maxLitTotal     Maximum lit segments for the whole group. 0 for no total limit.
+     * @param action          CLAMP (default) hides the topmost segments, DIM lowers the device brightness.
+     * @return Reference to this instance.
+     */
+    SBK_BarGroup &setPowerBudget(uint16_t maxLitPerDevice,
+                                 uint16_t maxLitTotal = 0,
+                                 PowerBudgetAction action = PowerBudgetAction::CLAMP)
+    {
+        _budgetDevice = maxLitPerDevice;
+        _budgetTotal = maxLitTotal;
+        _budgetAction = action;
+        _forceFlush = true;
+        _restoreBrightness();
+        return *this;
+    }
+
+    /**
+     * @brief Set the device brightness used while under budget, for the DIM action.
+     *
+     * By default, each device is dimmed from the brightness it had when the budget was first
+     * exceeded, read from the driver `getBrightness(devIdx)` when available, 15 otherwise.
+     * Devices under budget keep the brightness set by the sketch.
+     *
+     * @param level Driver brightness level (0–15).
+     * @return Reference to this instance.
+     */
+    SBK_BarGroup &setBudgetBrightness(uint8_t level)
+    {
+        _fullBrightness = min(level, (uint8_t)15);
+        for (uint8_t d = 0; d < 8; ++d)
+            _fullLevel[d] = _fullBrightness;
+        _restoreBrightness();
+        return *this;
+    }
+
+    /** @brief Returns true if the driver supports device power-down. */
+    static bool canPowerDown() { return SBK_DriverPower<DriverT>::supported; }
+
+    /**
+     * @brief Returns true if a device is currently powered down.
+     * @param devIdx Device index (0–7).
+     */
+    bool isPoweredDown(uint8_t devIdx) const { return (_downDevices >> (devIdx & 7)) & 1; }
+
+#ifdef SBK_BARDRIVE_WITH_ANIM
+    /**
+     * @brief Advance the animations of all bars.
+     * @param syncTime Optional timestamp to synchronize animations.
+     * @return true if at least one animation is still running.
+     */
+    bool update(uint32_t syncTime = millis())
+    {
+        bool running = false;
+        for (uint8_t i = 0; i < _barsNum; ++i)
+            running |= _bars[i]->animations().update(syncTime);
+        return running;
+    }
+#endif
+
+    /**
+     * @brief Flush all bars with a single driver `show()`, managing idle devices.
+     *
+     * The flush is skipped when no bar changed and none is modulated (software blink, dimming,
+     * dithering). Devices are powered down or woken up according to their bars activity;
+     * a device blinking in hardware needs no flush, but is never powered down.
+     *
+     * @param now Optional timestamp, in milliseconds.
+     * @return true if the driver was flushed, false if the flush was skipped.
+     */
+    bool show(uint32_t now = millis())
+    {
+        // Power-down time accounting
+        if (_downDevices)
+            _stats.poweredDownMs += (now - _lastShow) * __builtin_popcount(_downDevices);
+        _lastShow = now;
+
+        // Lit devices, counted before beginCommit() hides blanked, dimmed or dithered segments
+        uint8_t litDevs = 0;
+        for (uint8_t i = 0; i < _barsNum; ++i)
+            if (_bars[i]->barmeter().getLitCount())
+                litDevs |= _barDevices[i];
+
+        for (uint8_t i = 0; i < _barsNum; ++i)
+            _bars[i]->beginCommit();
+
+        // Per-device activity
+        uint8_t changedDevs = 0, activeDevs = 0, hwBlinkDevs = 0;
+        for (uint8_t i = 0; i < _barsNum; ++i)
+        {
+            SBK_BarMeter<DriverT> &meter = _bars[i]->barmeter();
+            if (meter.isChanged())
+            {
+                changedDevs |= _barDevices[i];
+                meter.clearChanged();
+            }
+            if (_bars[i]->isHardwareBlink())
+                hwBlinkDevs |= _barDevices[i]; // the chip blinks on its own, keep it powered
+            else if (meter.hasOutputFx() || _bars[i]->isBlinking())
+                activeDevs |= _barDevices[i];
+        }
+        activeDevs |= changedDevs;
+
+        if (_budgetDevice || _budgetTotal)
+            _enforceBudget();
+
+        for (uint8_t d = 0; d < 8; ++d)
+        {
+            const uint8_t bit = 1 << d;
+            if (!(_devices & bit))
+                continue;
+            if (activeDevs & bit)
+                _lastActivity[d] = now;
+            const bool idle = !(hwBlinkDevs & bit) &&
+                              ((_downWhenDark && !(litDevs & bit)) ||
+                               (_idleTimeout && (now - _lastActivity[d]) >= _idleTimeout));
+            if (idle != isPoweredDown(d))
+                _setPower(d, idle);
+        }
+
+        const bool flush = _forceFlush || (activeDevs & ~_downDevices);
+        if (flush)
+        {
+            _driver->show();
+            ++_stats.flushes;
+        }
+        else
+            ++_stats.skippedFlushes;
+        _forceFlush = false;
+
+        for (uint8_t i = 0; i < _barsNum; ++i)
+            _bars[i]->endCommit();
+        return flush;
+    }
+
+    /**
+     * @brief Wake up all powered down devices, restarting their idle time.
+     * @param now Optional timestamp, in milliseconds, on the same clock as `show()`.
+     */
+    void wakeUp(uint32_t now = millis())
+    {
+        for (uint8_t d = 0; d < 8; ++d)
+        {
+            _lastActivity[d] = now;
+            if (isPoweredDown(d))
+                _setPower(d, false);
+        }
+    }
+
+    /**
+     * @brief Get the group statistics.
+     * @return Const reference to the statistics.
+     */
+    const SBK_BarGroupStats &getStats() const { return _stats; }
+
+    /** @brief Reset the group statistics. */
+    void resetStats() { _stats = SBK_BarGroupStats(); }
+
+protected:
+    void _setPower(uint8_t devIdx, bool down)
+    {
+        if (!SBK_DriverPower<DriverT>::set(_driver, devIdx, down))
+            return;
+        const uint8_t bit = 1 << devIdx;
+        if (down)
+        {
+            _downDevices |= bit;
+            ++_stats.powerDowns;
+        }
+        else
+        {
+            _downDevices &= ~bit;
+            _forceFlush = true; // push what changed while asleep
+        }
+    }
+
+    // Scale each device lit count down to its allowance and apply the budget action
+    void _enforceBudget()
+    {
+        uint16_t devLit[8] = {0};
+        uint16_t total = 0;
+        for (uint8_t i = 0; i < _barsNum; ++i)
+        {
+            const uint8_t lit = _bars[i]->barmeter().getLitCount();
+            for (uint8_t d = 0; d < 8; ++d)
+                if (_barDevices[i] & (1 << d))
+                    devLit[d] += lit;
+            total += lit;
+        }
+
+        // Fast path: within budget, nothing to scale
+        const bool totalOver = _budgetTotal && total > _budgetTotal;
+        bool over = totalOver;
+        for (uint8_t d = 0; d < 8 && !over; ++d)
+            over = _budgetDevice && devLit[d] > _budgetDevice;
+        if (!over)
+        {
+            _restoreBrightness();
+            return;
+        }
+        ++_stats.overBudget;
+
+        // Allowance per device, as a fraction of its lit count (Q8, 256 = no limit)
+        uint16_t scale[8];
+        for (uint8_t d = 0; d < 8; ++d)
+        {
+            uint32_t allowed = devLit[d];
+            if (_budgetDevice && allowed > _budgetDevice)
+                allowed = _budgetDevice;
+            if (totalOver)
+                allowed = min(allowed, (uint32_t)devLit[d] * _budgetTotal / total);
+            scale[d] = (devLit[d] && allowed < devLit[d]) ? (uint16_t)((allowed << 8) / devLit[d]) : 256;
+        }
+
+        if (_budgetAction == PowerBudgetAction::DIM)
+        {
+            for (uint8_t d = 0; d < 8; ++d)
+            {
+                const uint8_t bit = 1 << d;
+                if (!(_devices & bit))
+                    continue;
+                if (scale[d] < 256)
+                {
+                    if (!(_dimmedDevices & bit))
+                    {
+                        // Dim from the brightness the device had
+                        if (_fullBrightness == NO_LEVEL)
+                            _fullLevel[d] = SBK_DriverBrightness<DriverT>::get(_driver, d, _fullLevel[d]);
+                        _dimmedDevices |= bit;
+                    }
+                    _setBrightness(d, (uint8_t)(((uint16_t)_fullLevel[d] * scale[d]) >> 8));
+                }
+                else if (_dimmedDevices & bit)
+                    _undim(d);
+            }
+        }
+        else
+        {
+            for (uint8_t i = 0; i < _barsNum; ++i)
+            {
+                uint16_t minScale = 256;
+                for (uint8_t d = 0; d < 8; ++d)
+                    if ((_barDevices[i] & (1 << d)) && scale[d] < minScale)
+                        minScale = scale[d];
+                if (minScale < 256)
+                {
+                    SBK_BarMeter<DriverT> &meter = _bars[i]->barmeter();
+                    meter.clampLit((uint8_t)(((uint16_t)meter.getLitCount() * minScale) >> 8));
+                }
+            }
+        }
+    }
+
+    inline void _setBrightness(uint8_t devIdx, uint8_t level)
+    {
+        if (_brightness[devIdx] == level)
+            return;
+        _brightness[devIdx] = level;
+        _driver->setBrightness(devIdx, level);
+    }
+
+    // Give a dimmed device its full brightness back, then leave its brightness to the sketch
+    void _undim(uint8_t devIdx)
+    {
+        _setBrightness(devIdx, _fullLevel[devIdx]);
+        _brightness[devIdx] = NO_LEVEL;
+        _dimmedDevices &= ~(1 << devIdx);
+    }
+
+    void _restoreBrightness()
+    {
+        if (!_dimmedDevices)
+            return;
+        for (uint8_t d = 0; d < 8; ++d)
+            if (_dimmedDevices & (1 << d))
+                _undim(d);
+    }
+
+    static const uint8_t NO_LEVEL = 0xFF;
+
+    DriverT *_driver;
+    BarT *_bars[MAX_BARS];
+    uint8_t _barDevices[MAX_BARS];
+    uint8_t _barsNum = 0;
+    uint8_t _devices = 0;
+    uint8_t _downDevices = 0;
+    bool _downWhenDark = false;
+    bool _forceFlush = true;
+    uint32_t _idleTimeout = 0;
+    uint32_t _lastActivity[8] = {0};
+    uint32_t _lastShow = 0;
+    uint16_t _budgetDevice = 0;
+    uint16_t _budgetTotal = 0;
+    PowerBudgetAction _budgetAction = PowerBudgetAction::CLAMP;
+    uint8_t _fullBrightness = NO_LEVEL; // set by setBudgetBrightness()
+    uint8_t _dimmedDevices = 0;
+    uint8_t _fullLevel[8] = {15, 15, 15, 15, 15, 15, 15, 15};
+    uint8_t _brightness[8] = {NO_LEVEL, NO_LEVEL, NO_LEVEL, NO_LEVEL, NO_LEVEL, NO_LEVEL, NO_LEVEL, NO_LEVEL};
+    SBK_BarGroupStats _stats;
+};
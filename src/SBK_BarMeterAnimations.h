@@ -33,6 +33,13 @@
 #pragma once
 
 #include <Arduino.h>
+#if defined(__AVR__)
+#include <util/atomic.h>
+#endif
+#include "SBK_BarTimebase.h"
+#include "SBK_BarClip.h"
+#include "SBK_BarScript.h"
+#include "SBK_BarCoroutine.h"
 
 /**
  * @class SBK_BarMeterAnimations
@@ -55,16 +62,9 @@ public:
     explicit SBK_BarMeterAnimations(BarMeterT &barMeter) : _barMeter(barMeter) {}
 
     /**
-     * @brief Destructor. Frees block memory if allocated.
+     * @brief Destructor. Frees block and random pixel memory if allocated.
      */
-    ~SBK_BarMeterAnimations()
-    {
-        if (_blocks)
-        {
-            delete[] _blocks;
-            _blocks = nullptr;
-        }
-    }
+    ~SBK_BarMeterAnimations() { _freeAnimMemory(); }
 
     /**
      * @brief Set the total number of segments the animation logic should handle.
@@ -86,9 +86,33 @@ public:
     {
         _currentTime = syncTime;
 
+        if (_hasPendingReq())
+            _latchRequests();
+
         if (!_isRunning || _isPaused || !_currentFunc)
             return false;
 
+        if (_timebase && _isClosedFormAnim())
+        {
+            if (_updateFromTimebase() && !_loop)
+            {
+                _isRunning = false;
+                _currentFunc = nullptr;
+            }
+            return _isRunning;
+        }
+
+        if (_timeline && _isClosedFormAnim())
+        {
+            if (_updateTimeline() && !_loop)
+            {
+                _isRunning = false;
+                _currentFunc = nullptr;
+                _timeline = false;
+            }
+            return _isRunning;
+        }
+
         if ((this->*_currentFunc)())
         {
             if (_loop)
@@ -115,6 +139,9 @@ public:
     SBK_BarMeterAnimations &animInit()
     {
         _init = true;
+        _animTime = 0;
+        _animTimeFrac = 0;
+        _timelineSynced = false;
         return *this;
     }
 
@@ -129,6 +156,7 @@ public:
     SBK_BarMeterAnimations &resume()
     {
         _isPaused = false;
+        _timelineSynced = false;
         return *this;
     }
 
@@ -140,6 +168,10 @@ public:
         _skipPending = false;
         _currentFunc = nullptr;
         _animLogicSet = false;
+        _timeline = false;
+#ifdef SBK_BARDRIVE_HAS_COROUTINES
+        _coroTask.reset();
+#endif
         return *this;
     }
 
@@ -258,6 +290,71 @@ public:
         return *this;
     }
 
+    /**
+     * @name ISR-safe control requests
+     * Safe to call from interrupts or other tasks. The request is posted atomically and
+     * applied by the next `update()`, before rendering, so a render never sees a half-changed
+     * state. Opposite requests posted before the next update cancel out (last one wins).
+     * @{
+     */
+    /** @brief Request `setLogic(newLogic)`. */
+    SBK_BarMeterAnimations &requestLogic(bool newLogic)
+    {
+        _postRequest(REQ_TOGGLE_LOGIC | REQ_LOGIC_VALUE, REQ_SET_LOGIC | (newLogic ? REQ_LOGIC_VALUE : 0), 0);
+        return *this;
+    }
+    /** @brief Request `toggleLogic()`. */
+    SBK_BarMeterAnimations &requestToggleLogic()
+    {
+        _postRequest(0, 0, REQ_TOGGLE_LOGIC);
+        return *this;
+    }
+    /** @brief Request `setDir(newDirection)`. */
+    SBK_BarMeterAnimations &requestDir(bool newDirection)
+    {
+        _postRequest(REQ_TOGGLE_DIR | REQ_DIR_VALUE, REQ_SET_DIR | (newDirection ? REQ_DIR_VALUE : 0), 0);
+        return *this;
+    }
+    /** @brief Request `toggleDir()`. */
+    SBK_BarMeterAnimations &requestToggleDir()
+    {
+        _postRequest(0, 0, REQ_TOGGLE_DIR);
+        return *this;
+    }
+    /** @brief Request `pause()`. */
+    SBK_BarMeterAnimations &requestPause()
+    {
+        _postRequest(REQ_RESUME, REQ_PAUSE, 0);
+        return *this;
+    }
+    /** @brief Request `resume()`. */
+    SBK_BarMeterAnimations &requestResume()
+    {
+        _postRequest(REQ_PAUSE, REQ_RESUME, 0);
+        return *this;
+    }
+    /** @brief Request `stopBlockEmission()`. */
+    SBK_BarMeterAnimations &requestStopBlockEmission()
+    {
+        _postRequest(REQ_RESUME_EMISSION, REQ_STOP_EMISSION, 0);
+        return *this;
+    }
+    /** @brief Request `resumeBlockEmission()`. */
+    SBK_BarMeterAnimations &requestResumeBlockEmission()
+    {
+        _postRequest(REQ_STOP_EMISSION, REQ_RESUME_EMISSION, 0);
+        return *this;
+    }
+    /** @brief Request `stop()`. Applied after the other pending requests. */
+    SBK_BarMeterAnimations &requestStop()
+    {
+        _postRequest(0, REQ_STOP, 0);
+        return *this;
+    }
+    /** @brief Returns true if requests are waiting for the next `update()`. */
+    bool hasPendingRequests() const { return _hasPendingReq(); }
+    /** @} */
+
     /** @brief Query if animation is currently active. */
     bool isRunning() const { return _isRunning; }
 
@@ -1109,6 +1206,57 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Scroll a repeating bit pattern upward (marquee).
+     *
+     * Pattern bit i is `(pattern[i / 8] >> (i % 8)) & 1`; the pattern repeats along the bar with a
+     * period of `patternBits` segments. Each step advances a ring offset and writes only the segments
+     * that changed, whatever the pattern length. Runs until stopped; `toggleLogic()` reverses the motion.
+     *
+     * @param pattern     Pattern bytes. Must outlive the animation.
+     * @param patternBits Pattern length in bits (segments).
+     * @param intv        Step interval in ms, down to 1. Default is 50.
+     * @param progmem     Set to `true` if the pattern is in PROGMEM. Default is `false` (RAM).
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &scrollingUpPattern(const uint8_t *pattern, uint16_t patternBits, uint16_t intv = 50, bool progmem = false)
+    {
+        _updateIntv1 = max((uint16_t)1, intv);
+        _pattern = pattern;
+        _patternBits = patternBits;
+        _patternProgmem = progmem;
+
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_scrollPattern;
+        return *this;
+    }
+
+    /**
+     * @brief Scroll a repeating bit pattern downward (marquee). See `scrollingUpPattern()`.
+     * @param pattern     Pattern bytes. Must outlive the animation.
+     * @param patternBits Pattern length in bits (segments).
+     * @param intv        Step interval in ms, down to 1. Default is 50.
+     * @param progmem     Set to `true` if the pattern is in PROGMEM. Default is `false` (RAM).
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &scrollingDownPattern(const uint8_t *pattern, uint16_t patternBits, uint16_t intv = 50, bool progmem = false)
+    {
+        _updateIntv1 = max((uint16_t)1, intv);
+        _pattern = pattern;
+        _patternBits = patternBits;
+        _patternProgmem = progmem;
+
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = true;
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_scrollPattern;
+        return *this;
+    }
+
     /**
      * @brief Drop blocks from top and stack from bottom up.
      * @param intv Update interval in milliseconds. Default is 50.
@@ -1124,8 +1272,6 @@ public:
         _updateIntv1 = max(5, intv);
         _param1 = blockLength;
         _param2 = blockSpacing;
-        _param3 = 0; // requested number of blocks
-        _param4 = 1; // aka maximum blocks number
         if (_init)
             _emittingBlocksEnabled = true;
         _isRunning = true;
@@ -1148,8 +1294,6 @@ public:
         _updateIntv1 = max(5, intv);
         _param1 = blockLength;
         _param2 = blockSpacing;
-        _param3 = 0; // aka requested number of blocks
-        _param4 = 1; // aka maximum blocks number
         if (_init)
             _emittingBlocksEnabled = true;
         _isRunning = true;
@@ -1172,8 +1316,6 @@ public:
         _updateIntv1 = max(5, intv);
         _param1 = blockLength;
         _param2 = blockSpacing;
-        _param3 = 0; // aka requested number of blocks
-        _param4 = 1; // aka maximum blocks number
         if (_init)
             _emittingBlocksEnabled = true;
         _isRunning = true;
@@ -1196,8 +1338,6 @@ public:
         _updateIntv1 = max(5, intv);
         _param1 = blockLength;
         _param2 = blockSpacing;
-        _param3 = 0; // aka requested number of blocks
-        _param4 = 1; // aka maximum blocks number
         if (_init)
             _emittingBlocksEnabled = true;
         _isRunning = true;
@@ -1205,6 +1345,80 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Bounce particles off the bottom of the bar under gravity.
+     *
+     * Each particle has a fixed-point position and velocity: gravity pulls it down, the bottom
+     * bounces it back up with the given restitution, and a particle at rest is launched again to
+     * a random height. Runs until stopped; `toggleLogic()` flips gravity.
+     *
+     * @param intv         Physics tick in milliseconds. Default is 10.
+     * @param numParticles Number of particles. Default is 3 (8 at most with `SBK_BARDRIVE_NO_HEAP`).
+     * @param gravity      Acceleration in 1/256 segment per tick². Default is 10.
+     * @param bounce       Percentage of speed kept at each bounce. Default is 80.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &bouncingParticles(uint16_t intv = 10, uint8_t numParticles = 3, uint8_t gravity = 10, uint8_t bounce = 80)
+    {
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _updateIntv1 = max(5, intv);
+        _param1 = max((uint8_t)1, gravity);
+        _param2 = (uint8_t)((min(bounce, (uint8_t)99) * 256) / 100);
+        _param3 = 0; // aka bounce on the bottom
+        _param4 = constrain(numParticles, 1, 64);
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_particlePhysics;
+        return *this;
+    }
+
+    /**
+     * @brief Drop particles from top under gravity, bouncing on the stack before settling on it.
+     * @param intv         Physics tick in milliseconds. Default is 10.
+     * @param numParticles Number of particles falling at once. Default is 3 (8 at most with `SBK_BARDRIVE_NO_HEAP`).
+     * @param gravity      Acceleration in 1/256 segment per tick². Default is 10.
+     * @param bounce       Percentage of speed kept at each bounce. Default is 40.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &downStackingParticles(uint16_t intv = 10, uint8_t numParticles = 3, uint8_t gravity = 10, uint8_t bounce = 40)
+    {
+        _isNonInvertingLogicAnim = true;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _updateIntv1 = max(5, intv);
+        _param1 = max((uint8_t)1, gravity);
+        _param2 = (uint8_t)((min(bounce, (uint8_t)99) * 256) / 100);
+        _param3 = 1; // aka stack on the bottom
+        _param4 = constrain(numParticles, 1, 64);
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_particlePhysics;
+        return *this;
+    }
+
+    /**
+     * @brief Launch particles from bottom against reversed gravity, stacking at the top.
+     * @param intv         Physics tick in milliseconds. Default is 10.
+     * @param numParticles Number of particles flying at once. Default is 3 (8 at most with `SBK_BARDRIVE_NO_HEAP`).
+     * @param gravity      Acceleration in 1/256 segment per tick². Default is 10.
+     * @param bounce       Percentage of speed kept at each bounce. Default is 40.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &upStackingParticles(uint16_t intv = 10, uint8_t numParticles = 3, uint8_t gravity = 10, uint8_t bounce = 40)
+    {
+        _isNonInvertingLogicAnim = true;
+        _animRenderDirIsReversed = true;
+        _AnimInitLogicIsInverted = false;
+        _updateIntv1 = max(5, intv);
+        _param1 = max((uint8_t)1, gravity);
+        _param2 = (uint8_t)((min(bounce, (uint8_t)99) * 256) / 100);
+        _param3 = 1; // aka stack on the bottom
+        _param4 = constrain(numParticles, 1, 64);
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_particlePhysics;
+        return *this;
+    }
+
     /**
      * @brief Follow analog signal with smoothing for fill animation.
      * @param sigPtr Pointer to analog signal.
@@ -1369,6 +1583,44 @@ public:
         return *this;
     }
 
+    /**
+     * @brief Let the follow signal animations find their signal range by themselves.
+     *
+     * The signal is mapped between slowly decaying min/max envelopes instead of the fixed
+     * `minMap`/`maxMap`, which only give the starting range: a new peak widens the range at once,
+     * then the range relaxes back toward the signal. The mapped range is only moved once an envelope
+     * drifts by a segment's worth, so the bar does not breathe with every sample.
+     * Stays enabled for the next follow animations until `noAutoRange()`.
+     *
+     * @param decay     Envelope decay per sampling interval: 1/2^decay of the distance to the signal (1–15).
+     *                  Default is 9, about 2.5 s to settle at the default 5 ms sampling interval. The dual
+     *                  signal animations track both signals in one envelope, decayed once per interval.
+     * @param noiseGate Minimum range, in raw signal units. A signal moving less than this stays near
+     *                  the bottom instead of being stretched to full scale. Default is 0 (off).
+     * @return Reference to this animation instance (chainable).
+     */
+    SBK_BarMeterAnimations &autoRange(uint8_t decay = 9, uint16_t noiseGate = 0)
+    {
+        _autoRange = true;
+        _autoRangeDecay = constrain(decay, 1, 15);
+        _autoRangeGate = noiseGate;
+        _autoRangeInit();
+        return *this;
+    }
+
+    /** @brief Back to the fixed signal range. The range found so far is kept until the next follow animation. */
+    SBK_BarMeterAnimations &noAutoRange()
+    {
+        _autoRange = false;
+        return *this;
+    }
+
+    /** @brief Get the signal value currently mapped to an empty bar. */
+    uint16_t getRangeMin() const { return _minMap; }
+
+    /** @brief Get the signal value currently mapped to a full bar. */
+    uint16_t getRangeMax() const { return _maxMap; }
+
     /**
      * @brief Randomly light up pixels until the bar is full.
      * @param interval Update interval in milliseconds. Default is 30.
@@ -1405,109 +1657,621 @@ public:
         return *this;
     }
 
-protected:
-    BarMeterT &_barMeter;
-    uint8_t _segsNum = 0;
+    /**
+     * @brief Play a precomputed frame table (see `SBK_BarClip` and `SBK_BarClipRecorder`).
+     *
+     * Each tick costs one table read and a write of the segments that changed; repeated
+     * frames of an RLE clip cost nothing. Direction and logic inversion apply as for the
+     * built-in animations. The clip data must outlive the animation.
+     *
+     * @param clip      Clip descriptor (copied).
+     * @param frameIntv Time between frames in milliseconds. Default is 40.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &playClip(const SBK_BarClip &clip, uint16_t frameIntv = 40)
+    {
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _usePtr = false;
+        _sigPtr2 = nullptr;
+        _sigPtr1 = nullptr;
+        _clip = clip;
+        _updateIntv1 = max((uint16_t)5, frameIntv);
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_playClip;
+        return *this;
+    }
 
-    // Active animation update function
-    using AnimUpdateFn = bool (SBK_BarMeterAnimations::*)();
-    AnimUpdateFn _currentFunc = nullptr;
+    /**
+     * @brief Run a bytecode choreography (see `SBK_BarScript.h`).
+     *
+     * Instructions are fetched from the script one at a time: a script of any length uses
+     * the same few bytes of RAM. The animation completes at `SBK_SCRIPT_END`, so `loop()`
+     * replays the whole script. Direction and logic inversion apply as for built-in animations.
+     *
+     * @param script  Script bytes, assembled with the `SBK_SCRIPT_*` macros. Must outlive the animation.
+     * @param progmem Set to `false` if the script is in RAM. Default is `true` (PROGMEM).
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &playScript(const uint8_t *script, bool progmem = true)
+    {
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _usePtr = false;
+        _sigPtr2 = nullptr;
+        _sigPtr1 = nullptr;
+        _script = script;
+        _scriptProgmem = progmem;
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_runScript;
+        return *this;
+    }
 
-    // Control flags
-    bool _init = true; // true = init function
-    bool _isRunning = false;
-    bool _isPaused = false;
-    bool _loop = false;
-    bool _isLoopingNow = false;
-    bool _AnimInitLogicIsInverted = false;
-    bool _animRenderLogicIsInverted = false;
-    bool _prevAnimRenderLogic = false;
-    bool _isNonInvertingLogicAnim = false;
-    bool _mirrorHalfRangeDir = false;
-    bool _animLogicSet = false;
-    bool _skipPending = false;
-    bool _animRenderDirIsReversed = false;
-    bool _AnimInitDirIsReversed = false;
-    bool _animDirSet = false;
-    bool _usePtr = false;
-    bool _emittingBlocksEnabled = true;
+    /**
+     * @class EffectContext
+     * @brief Services handed to a custom effect renderer by `playEffect()`.
+     *
+     * Pixel indexes are logical: the animation direction and logic inversion are applied here,
+     * exactly as for built-in animations. Everything is inlined in the effect call.
+     */
+    class EffectContext
+    {
+    public:
+        explicit EffectContext(SBK_BarMeterAnimations &anim) : _anim(anim) {}
 
-    // Time trackings
-    uint32_t _currentTime = 0;
-    uint32_t _lastUpdate1 = 0, _lastUpdate2 = 0, _lastUpdate3 = 0;
+        /** @brief Returns true on the first frame of a cycle (start, or restart by `loop()`). */
+        bool init() const { return _anim._init; }
 
-    // Animations update interval trackers
-    uint16_t _updateIntv1 = 10, _updateIntv2 = 10, _updateIntv3 = 10;
+        /** @brief Get the current animation time in milliseconds. */
+        uint32_t now() const { return _anim._currentTime; }
 
-    // Animations trackers
-    uint8_t _sequenceState = 0;
-    int8_t _ledTracker1 = 0, _ledTracker2 = 0, _ledTracker3 = 0;
-    int8_t _minTracker = 0, _maxTracker = 1;
-    uint8_t _param1 = 0, _param2 = 0, _param3 = 0, _param4 = 0, _param5 = 0;
-    uint16_t _smoothedValue1 = 0, _smoothedValue2 = 0;
-    uint16_t _minMap = 0, _maxMap = 1023;
-    uint8_t _counter1 = 0, _counter2 = 0;
-    // Live signals trackers
-    const uint16_t *_sigPtr1 = nullptr, *_sigPtr2 = nullptr;
-    // Blocks related helpers
-    struct Block
-    {
-        Block() : position(-1), active(false) {}
-        int8_t position;
-        bool active;
-    };
-    Block *_blocks = nullptr;
+        /**
+         * @brief Step timer: returns true once per interval, aligned on an attached timebase if any.
+         * @param intv Step interval in milliseconds.
+         */
+        bool every(uint16_t intv)
+        {
+            if (_anim._currentTime - _anim._lastUpdate1 < intv)
+                return false;
+            _anim._lastUpdate1 = _anim._stepTime(intv);
+            return true;
+        }
 
-    // Animation helpers
-    static inline void _normalizePercentRange(uint8_t &minP, uint8_t &maxP)
-    {
-        minP = constrain(minP, 0, 100);
-        maxP = constrain(maxP, 0, 100);
-        if (minP > maxP)
+        /** @brief Get the number of segments of the bar. */
+        uint8_t segsNum() const { return _anim._segsNum; }
+
+        /** @brief Returns true if the rendering logic is inverted. */
+        bool isLogicInverted() const { return _anim._animRenderLogicIsInverted; }
+
+        /**
+         * @brief Set a segment, direction corrected and logic inverted as the animation is.
+         * @param pixel Logical segment index (0 = start of the animation).
+         * @param on    Logical state (true = lit in normal logic).
+         */
+        void setPixel(uint8_t pixel, bool on)
         {
-            uint8_t t = maxP;
-            maxP = minP;
-            minP = t;
+            if (pixel < _anim._segsNum)
+                _anim._barMeter.setPixel(_anim._corrPixelToDir(pixel), on != _anim._animRenderLogicIsInverted);
         }
-        if (minP == maxP)
+
+        /** @brief Get the logical state of a segment (see `setPixel()`). */
+        bool getPixel(uint8_t pixel) const
         {
-            if (maxP < 100)
-                maxP = minP + 1;
-            else
-                minP--;
+            return pixel < _anim._segsNum &&
+                   (_anim._barMeter.getPixelState(_anim._corrPixelToDir(pixel)) != _anim._animRenderLogicIsInverted);
         }
-    }
-    inline void _mapMinMaxTrackerFromPtr(const uint16_t *minPercPtr, const uint16_t *maxPercPtr, int8_t minR, uint8_t maxR)
-    {
-        if (!_usePtr)
-            return;
-        uint8_t minP = minPercPtr ? *minPercPtr : 0;
-        uint8_t maxP = maxPercPtr ? *maxPercPtr : 100;
-        _normalizePercentRange(minP, maxP);
-        _minTracker = map(minP, 0, 100, minR, maxR);
-        _maxTracker = map(maxP, 0, 100, minR, maxR);
-    }
-    inline void _mapMinMaxTracker(uint8_t minP, uint8_t maxP, uint8_t minR, uint8_t maxR)
-    {
-        _normalizePercentRange(minP, maxP);
-        _minTracker = map(minP, 0, 100, minR, maxR);
-        _maxTracker = map(maxP, 0, 100, minR, maxR);
-    }
-    inline uint8_t _corrPixelToDir(uint8_t pixel)
-    {
-        return _animRenderDirIsReversed ? (_segsNum - 1) - pixel : pixel;
-    }
-    inline uint8_t _corrPixelToDirForHalfRange(uint8_t pixel)
-    {
-        if (!_mirrorHalfRangeDir)
-            return pixel;
 
-        const uint8_t half = _segsNum / 2;
-        return abs((half - 1) - pixel);
-    }
-    static inline void _correctSwapOrEqualMinMax(uint16_t &minVal, uint16_t &maxVal)
-    {
-        if (minVal > maxVal)
+        /** @brief Set every segment to the logical off state. */
+        void clear()
+        {
+            for (uint8_t i = 0; i < _anim._segsNum; ++i)
+                setPixel(i, false);
+        }
+
+        /** @brief Direct access to the bar, without direction or logic correction. */
+        BarMeterT &bar() { return _anim._barMeter; }
+
+    private:
+        SBK_BarMeterAnimations &_anim;
+    };
+
+    /**
+     * @brief Run a custom effect under the animation machinery (timing, direction, logic, loop, pause).
+     *
+     * The effect is any object callable as `bool effect(EffectContext &ctx)`, returning true when a
+     * cycle is complete. It is called through a template trampoline, with no virtual dispatch, so a
+     * custom effect costs the same as a built-in animation. A C++11 functor with a template call
+     * operator works on every bar type:
+     *
+     * @code
+     * struct Chaser {
+     *     uint8_t pos = 0;
+     *     template <typename Ctx> bool operator()(Ctx &ctx) {
+     *         if (ctx.init()) { ctx.clear(); pos = 0; }
+     *         if (!ctx.every(30)) return false;
+     *         ctx.setPixel(pos, false);
+     *         pos = (pos + 1) % ctx.segsNum();
+     *         ctx.setPixel(pos, true);
+     *         return pos == 0; // one cycle per pass
+     *     }
+     * } chaser;
+     *
+     * bar.animations().animInit().playEffect(chaser).loop();
+     * @endcode
+     *
+     * @tparam EffectT Effect type, deduced.
+     * @param effect   Effect instance. Must outlive the animation.
+     * @return Reference to this animation instance.
+     */
+    template <typename EffectT>
+    SBK_BarMeterAnimations &playEffect(EffectT &effect)
+    {
+        _isNonInvertingLogicAnim = false;
+        _animRenderDirIsReversed = false;
+        _AnimInitLogicIsInverted = false;
+        _usePtr = false;
+        _sigPtr2 = nullptr;
+        _sigPtr1 = nullptr;
+        _effect = &effect;
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::template _runEffect<EffectT>;
+        return *this;
+    }
+
+#ifdef SBK_BARDRIVE_HAS_COROUTINES
+    /** @brief Coroutine animation script: draws on the bar and suspends with `SBK_BarCoro` awaitables. */
+    typedef SBK_BarAnimTask (*CoroutineFn)(BarMeterT &bar);
+
+    /**
+     * @brief Run a coroutine animation (see `SBK_BarCoroutine.h`).
+     *
+     * The coroutine is started on the next `update()` and resumed by later updates once its
+     * wait is over. The animation completes when the coroutine returns; `loop()` starts a new one.
+     *
+     * @param script Coroutine function, called with the bar to draw on.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &playCoroutine(CoroutineFn script)
+    {
+        _isNonInvertingLogicAnim = true;
+        _animRenderDirIsReversed = false;
+        _usePtr = false;
+        _coroScript = script;
+        _isRunning = true;
+        _currentFunc = &SBK_BarMeterAnimations::_runCoroutine;
+        return *this;
+    }
+#endif
+
+    /**
+     * @brief Jump to a point of the current animation timeline.
+     *
+     * Supported by the deterministic fill/empty, bounce fill, and center/edges bounce animations,
+     * which are then rendered in closed form from their timeline position instead of step by step.
+     * The frame at `t` is drawn on the next `update()`, playback continuing from there.
+     *
+     * @param t Position in milliseconds from the animation start. Looping animations wrap it to one cycle.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &seek(uint32_t t)
+    {
+        _timeline = true;
+        _timelineFunc = _currentFunc;
+        const uint32_t dur = getDuration();
+        _animTime = (_loop && dur) ? t % dur : min(t, dur);
+        _animTimeFrac = 0;
+        _timelineSynced = false;
+        return *this;
+    }
+
+    /**
+     * @brief Set the playback speed of the current animation timeline.
+     *
+     * Any value other than 100 switches a supported animation to timeline playback (see `seek()`),
+     * from its current timeline position. Negative values play the animation backwards.
+     *
+     * @param speedPercent Playback speed in percent: 100 = normal, 200 = twice as fast, -100 = reverse. Default is 100.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &setSpeed(int16_t speedPercent = 100)
+    {
+        _speed = speedPercent;
+        if (speedPercent != 100 && !_timeline)
+        {
+            _timeline = true;
+            _timelineFunc = _currentFunc;
+            _timelineSynced = false;
+        }
+        return *this;
+    }
+
+    /**
+     * @brief Lock the animation to a shared timebase.
+     *
+     * Closed-form animations (fill/empty, bounce fill, center/edges bounce) take their timeline
+     * position directly from the timebase, plus `phaseOffset`, so every attached bar shows the
+     * same frame (or a deliberately shifted one) whenever it was started. One-shot animations end
+     * once the timebase passes their duration: `restart()` the timebase to replay them in sync.
+     *
+     * Other step-driven animations align their steps on the timebase grid instead of their own
+     * start time, so bars started together keep stepping together.
+     *
+     * @param timebase    Timebase to attach to. Must outlive the attachment.
+     * @param phaseOffset Optional offset in milliseconds, ahead of the timebase. Default is 0.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &attachTimebase(const SBK_BarTimebase &timebase, uint32_t phaseOffset = 0)
+    {
+        _timebase = &timebase;
+        _phaseOffset = phaseOffset;
+        _timebaseSynced = false;
+        return *this;
+    }
+
+    /**
+     * @brief Release the shared timebase. The animation continues on its own clock.
+     * @return Reference to this animation instance.
+     */
+    SBK_BarMeterAnimations &detachTimebase()
+    {
+        _timebase = nullptr;
+        return *this;
+    }
+
+    /** @brief Returns true if the animation is locked to a shared timebase. */
+    bool hasTimebase() const { return _timebase != nullptr; }
+
+    /** @brief Get the timeline playback speed, in percent. */
+    int16_t getSpeed() const { return _speed; }
+
+    /** @brief Get the current timeline position, in milliseconds from the animation start. */
+    uint32_t getPosition() const { return _animTime; }
+
+    /**
+     * @brief Get the length of one cycle of the current animation.
+     * @return Cycle length in milliseconds, or 0 if the animation has no closed form.
+     */
+    uint32_t getDuration()
+    {
+        if (!_isClosedFormAnim())
+            return 0;
+        int8_t minT, maxT;
+        _closedFormRange(minT, maxT);
+        const uint8_t steps = abs(maxT - minT) + 1;
+        if (_isBounceAnim())
+            return (uint32_t)steps * (_updateIntv2 + _updateIntv3);
+        return (uint32_t)steps * _updateIntv1;
+    }
+
+    /**
+     * @brief Draw the current animation as it is `t` milliseconds after its start.
+     *
+     * Pure function of `t`: no animation state is read or changed, so frames can be drawn in any order.
+     *
+     * @param t Position in milliseconds from the animation start, up to `getDuration()`.
+     * @return true if drawn, false if the current animation has no closed form.
+     */
+    bool renderAt(uint32_t t)
+    {
+        if (!_isClosedFormAnim())
+            return false;
+        int8_t minT, maxT;
+        _closedFormRange(minT, maxT);
+
+        const uint8_t steps = abs(maxT - minT) + 1;
+        bool inverted = _animLogicSet ? _animRenderLogicIsInverted : _AnimInitLogicIsInverted;
+        uint16_t intv = _updateIntv1;
+        if (_isBounceAnim())
+        {
+            // Fill phase then empty phase
+            const uint32_t fillDur = (uint32_t)steps * _updateIntv2;
+            intv = _updateIntv2;
+            if (t >= fillDur)
+            {
+                t -= fillDur;
+                inverted = !inverted;
+                intv = _updateIntv3;
+            }
+        }
+        const uint8_t done = (uint8_t)min((uint32_t)steps, t / max((uint16_t)1, intv));
+
+        if (_isHalfRangeAnim())
+        {
+            // Half range index i is lit from a threshold moving through [maxT, minT + 1]
+            const uint8_t center = _segsNum / 2;
+            const int16_t thr = inverted ? (maxT + done) : (minT + 1 - done);
+            for (uint8_t i = 0; i < center; ++i)
+            {
+                const uint8_t px = _corrPixelToDirForHalfRange(i);
+                const bool on = (int16_t)i >= thr;
+                _barMeter.setPixel(px, on);
+                _barMeter.setPixel((_segsNum - 1) - px, on);
+            }
+        }
+        else
+        {
+            // Segments below `lit` are on, moving through [minT, maxT + 1]
+            const int16_t lit = inverted ? (maxT + 1 - done)
+                                         : min((int16_t)(maxT + 1), (int16_t)(minT + 1 + done));
+            for (uint8_t i = 0; i < _segsNum; ++i)
+                _barMeter.setPixel(_corrPixelToDir(i), (int16_t)i < lit);
+        }
+        return true;
+    }
+
+protected:
+    BarMeterT &_barMeter;
+    uint8_t _segsNum = 0;
+
+    // Active animation update function
+    using AnimUpdateFn = bool (SBK_BarMeterAnimations::*)();
+    AnimUpdateFn _currentFunc = nullptr;
+
+    // Control flags
+    bool _init = true; // true = init function
+    bool _isRunning = false;
+    bool _isPaused = false;
+
+    bool _loop = false;
+    bool _isLoopingNow = false;
+    bool _AnimInitLogicIsInverted = false;
+    bool _animRenderLogicIsInverted = false;
+    bool _prevAnimRenderLogic = false;
+    bool _isNonInvertingLogicAnim = false;
+    bool _mirrorHalfRangeDir = false;
+    bool _animLogicSet = false;
+    bool _skipPending = false;
+    bool _animRenderDirIsReversed = false;
+    bool _AnimInitDirIsReversed = false;
+    bool _animDirSet = false;
+    bool _usePtr = false;
+    bool _emittingBlocksEnabled = true;
+
+    // ISR-safe control requests: bits posted from ISRs/tasks by the request*() methods,
+    // latched and applied once at the start of update(). Only _pendingReq is shared.
+    static const uint16_t REQ_SET_LOGIC = 0x0001;       // requestLogic(): set logic to REQ_LOGIC_VALUE
+    static const uint16_t REQ_LOGIC_VALUE = 0x0002;     // requested logic (1 = inverted)
+    static const uint16_t REQ_TOGGLE_LOGIC = 0x0004;    // requestToggleLogic(), flipped on each request
+    static const uint16_t REQ_SET_DIR = 0x0008;         // requestDir(): set direction to REQ_DIR_VALUE
+    static const uint16_t REQ_DIR_VALUE = 0x0010;       // requested direction (1 = reversed)
+    static const uint16_t REQ_TOGGLE_DIR = 0x0020;      // requestToggleDir(), flipped on each request
+    static const uint16_t REQ_PAUSE = 0x0040;           // requestPause()
+    static const uint16_t REQ_RESUME = 0x0080;          // requestResume()
+    static const uint16_t REQ_STOP_EMISSION = 0x0100;   // requestStopBlockEmission()
+    static const uint16_t REQ_RESUME_EMISSION = 0x0200; // requestResumeBlockEmission()
+    static const uint16_t REQ_STOP = 0x0400;            // requestStop(), applied last
+    volatile uint16_t _pendingReq = 0;
+
+    // Timeline (closed-form) playback
+    bool _timeline = false;
+    bool _timelineSynced = false;
+    int16_t _speed = 100;
+    uint8_t _animTimeFrac = 0;
+    uint32_t _animTime = 0, _lastTimelineUpdate = 0;
+    AnimUpdateFn _timelineFunc = nullptr;
+    const SBK_BarTimebase *_timebase = nullptr;
+    uint32_t _phaseOffset = 0;
+    bool _timebaseSynced = false;
+    uint8_t _timebaseFrac = 0;
+    int16_t _timebaseSpeed = 100;
+    uint32_t _timebasePos = 0, _lastTimebaseElapsed = 0;
+
+    // Clip playback
+    SBK_BarClip _clip = {nullptr, 0, 0, 0};
+    uint16_t _clipPos = 0, _clipFrame = 0;
+    uint16_t _clipPrev = 0xFFFF; // Offset of the frame last drawn, 0xFFFF: none (draw every segment)
+
+    // Script playback
+    const uint8_t *_script = nullptr;
+    bool _scriptProgmem = true;
+    uint16_t _scriptPc = 0;
+    uint8_t _scriptLoopDepth = 0;
+    uint8_t _scriptLoopCount[SBK_SCRIPT_MAX_NESTING];
+    uint16_t _scriptLoopPc[SBK_SCRIPT_MAX_NESTING];
+
+    // Pattern scroller
+    const uint8_t *_pattern = nullptr;
+    uint16_t _patternBits = 0, _patternPos = 0;
+    bool _patternProgmem = false;
+
+    // Custom effect playback
+    void *_effect = nullptr;
+    bool _effectDirReversed = false;
+
+#ifdef SBK_BARDRIVE_HAS_COROUTINES
+    // Coroutine playback
+    CoroutineFn _coroScript = nullptr;
+    SBK_BarAnimTask _coroTask;
+#endif
+
+    // Time trackings
+    uint32_t _currentTime = 0;
+    uint32_t _lastUpdate1 = 0, _lastUpdate2 = 0, _lastUpdate3 = 0;
+
+    // Animations update interval trackers
+    uint16_t _updateIntv1 = 10, _updateIntv2 = 10, _updateIntv3 = 10;
+
+    // Animations trackers
+    uint8_t _sequenceState = 0;
+    int8_t _ledTracker1 = 0, _ledTracker2 = 0, _ledTracker3 = 0;
+    int8_t _minTracker = 0, _maxTracker = 1;
+    uint8_t _param1 = 0, _param2 = 0, _param3 = 0, _param4 = 0, _param5 = 0;
+    uint16_t _smoothedValue1 = 0, _smoothedValue2 = 0;
+    uint16_t _minMap = 0, _maxMap = 1023;
+    // Auto-ranging
+    bool _autoRange = false;
+    uint8_t _autoRangeDecay = 9;
+    uint16_t _autoRangeGate = 0;
+    uint32_t _envLow = 0, _envHigh = (uint32_t)1023 << 8; // Q8 envelopes
+    uint8_t _counter1 = 0, _counter2 = 0;
+    // Live signals trackers
+    const uint16_t *_sigPtr1 = nullptr, *_sigPtr2 = nullptr;
+    // Blocks related helpers
+    uint32_t *_laneWords = nullptr; // scrolling and mirror block lanes, particle frame
+    uint8_t *_pixelOrder = nullptr; // random pixel order
+    // Particles related helpers
+    struct Particle
+    {
+        uint16_t pos; // Q8.8 segments above the bottom
+        int16_t vel;  // Q8.8 segments per tick, upward
+        bool active;
+    };
+    Particle *_particles = nullptr;
+
+    static const uint8_t LANE_DRAWN = 0x01;    // bar shows the pixel lane
+    static const uint8_t LANE_REVERSED = 0x02; // bar direction the lane was drawn with
+    static const uint8_t LANE_INVERTED = 0x04; // render logic the lane was drawn with
+
+#ifdef SBK_BARDRIVE_NO_HEAP
+    static const uint8_t PIXEL_ORDER_CAP = SBK_BARDRIVE_MAX_SEGS; // segments shuffled by random pixel animations
+    static const uint8_t POOL_PARTICLES = 8;                      // particles of particle animations
+
+    // Pixel lane and head lane of a SBK_BARDRIVE_MAX_SEGS bar, any block length
+    static const uint8_t LANE_WORDS = 2 * ((SBK_BARDRIVE_MAX_SEGS + 31) / 32) + 8;
+
+    static_assert(SBK_BARDRIVE_MAX_SEGS >= 1 && SBK_BARDRIVE_MAX_SEGS <= 255,
+                  "SBK_BARDRIVE_MAX_SEGS must be 1 to 255");
+
+    // One animation runs at a time: lanes, particles and random pixel order share the pool
+    union AnimPool
+    {
+        AnimPool() {}
+        uint32_t lanes[LANE_WORDS];
+        uint8_t pixelOrder[SBK_BARDRIVE_MAX_SEGS];
+        struct
+        {
+            Particle list[POOL_PARTICLES];
+            uint32_t frame[(SBK_BARDRIVE_MAX_SEGS + 31) / 32];
+        } particles;
+    } _pool;
+#else
+    static const uint8_t PIXEL_ORDER_CAP = 255;
+#endif
+
+    /**
+     * Get zeroed storage for the block lanes.
+     * Returns false if they do not fit, with SBK_BARDRIVE_NO_HEAP.
+     */
+    bool _allocLanes(uint8_t words)
+    {
+        _freeAnimMemory();
+#ifdef SBK_BARDRIVE_NO_HEAP
+        if (words > LANE_WORDS)
+            return false;
+        _laneWords = _pool.lanes;
+        for (uint8_t i = 0; i < words; ++i)
+            _laneWords[i] = 0;
+#else
+        _laneWords = new uint32_t[words]();
+#endif
+        return true;
+    }
+
+    /**
+     * Get storage for the random pixel order.
+     * Returns the number of entries available, _segsNum or less with SBK_BARDRIVE_NO_HEAP.
+     */
+    uint8_t _allocPixelOrder()
+    {
+        _freeAnimMemory();
+#ifdef SBK_BARDRIVE_NO_HEAP
+        _pixelOrder = _pool.pixelOrder;
+        return min(_segsNum, (uint8_t)PIXEL_ORDER_CAP);
+#else
+        _pixelOrder = new uint8_t[_segsNum];
+        return _segsNum;
+#endif
+    }
+
+    /**
+     * Get storage for n inactive particles and a zeroed frame of the bar.
+     * Returns the number of particles available, n or less with SBK_BARDRIVE_NO_HEAP (0 if the bar is too long).
+     */
+    uint8_t _allocParticles(uint8_t n)
+    {
+        _freeAnimMemory();
+        const uint8_t words = (_segsNum + 31) >> 5;
+#ifdef SBK_BARDRIVE_NO_HEAP
+        if (_segsNum > SBK_BARDRIVE_MAX_SEGS)
+            return 0;
+        n = min(n, POOL_PARTICLES);
+        _particles = _pool.particles.list;
+        _laneWords = _pool.particles.frame;
+#else
+        _particles = new Particle[n];
+        _laneWords = new uint32_t[words];
+#endif
+        for (uint8_t i = 0; i < n; ++i)
+            _particles[i].active = false;
+        for (uint8_t i = 0; i < words; ++i)
+            _laneWords[i] = 0;
+        return n;
+    }
+
+    void _freeAnimMemory()
+    {
+#ifndef SBK_BARDRIVE_NO_HEAP
+        delete[] _laneWords;
+        delete[] _pixelOrder;
+        delete[] _particles;
+#endif
+        _laneWords = nullptr;
+        _pixelOrder = nullptr;
+        _particles = nullptr;
+    }
+
+    // Animation helpers
+    static inline void _normalizePercentRange(uint8_t &minP, uint8_t &maxP)
+    {
+        minP = constrain(minP, 0, 100);
+        maxP = constrain(maxP, 0, 100);
+        if (minP > maxP)
+        {
+            uint8_t t = maxP;
+            maxP = minP;
+            minP = t;
+        }
+        if (minP == maxP)
+        {
+            if (maxP < 100)
+                maxP = minP + 1;
+            else
+                minP--;
+        }
+    }
+    inline void _mapMinMaxTrackerFromPtr(const uint16_t *minPercPtr, const uint16_t *maxPercPtr, int8_t minR, uint8_t maxR)
+    {
+        if (!_usePtr)
+            return;
+        uint8_t minP = minPercPtr ? *minPercPtr : 0;
+        uint8_t maxP = maxPercPtr ? *maxPercPtr : 100;
+        _normalizePercentRange(minP, maxP);
+        _minTracker = map(minP, 0, 100, minR, maxR);
+        _maxTracker = map(maxP, 0, 100, minR, maxR);
+    }
+    inline void _mapMinMaxTracker(uint8_t minP, uint8_t maxP, uint8_t minR, uint8_t maxR)
+    {
+        _normalizePercentRange(minP, maxP);
+        _minTracker = map(minP, 0, 100, minR, maxR);
+        _maxTracker = map(maxP, 0, 100, minR, maxR);
+    }
+    inline uint8_t _corrPixelToDir(uint8_t pixel)
+    {
+        return _animRenderDirIsReversed ? (_segsNum - 1) - pixel : pixel;
+    }
+    inline uint8_t _corrPixelToDirForHalfRange(uint8_t pixel)
+    {
+        if (!_mirrorHalfRangeDir)
+            return pixel;
+
+        const uint8_t half = _segsNum / 2;
+        return abs((half - 1) - pixel);
+    }
+    static inline void _correctSwapOrEqualMinMax(uint16_t &minVal, uint16_t &maxVal)
+    {
+        if (minVal > maxVal)
         {
             uint16_t temp = maxVal;
             maxVal = minVal;
@@ -1527,10 +2291,264 @@ protected:
     }
     static inline uint8_t _getMappedSignal(uint16_t sig, uint16_t minM, uint16_t maxM, uint8_t minR, uint8_t maxR)
     {
+        if (sig <= minM) // below range, map() would go negative
+            return minR;
+        if (sig >= maxM) // above range, map() would overflow uint8_t
+            return maxR;
         uint8_t mapped = map(sig, minM, maxM, minR, maxR);
         return constrain(mapped, minR, maxR); // avoid edge overshoot
     }
 
+    // Auto-ranging: min/max envelopes in Q8, seeded from the current range
+    inline void _autoRangeInit()
+    {
+        _envLow = (uint32_t)_minMap << 8;
+        _envHigh = (uint32_t)_maxMap << 8;
+    }
+
+    // Track one smoothed sample; the mapped range follows the envelopes by steps of one segment
+    inline void _autoRangeSample(uint16_t sig) { _autoRangeSample(sig, sig); }
+
+    // Track one sampling interval of sigLow..sigHigh (both signals of the dual animations), decaying once
+    void _autoRangeSample(uint16_t sigLow, uint16_t sigHigh)
+    {
+        const uint32_t sLow = (uint32_t)sigLow << 8;
+        const uint32_t sHigh = (uint32_t)sigHigh << 8;
+        if (sLow < _envLow)
+            _envLow = sLow; // attack at once
+        else
+            _envLow += (sLow - _envLow) >> _autoRangeDecay;
+        if (sHigh > _envHigh)
+            _envHigh = sHigh;
+        else
+            _envHigh -= (_envHigh - sHigh) >> _autoRangeDecay;
+
+        uint16_t lo = _envLow >> 8;
+        uint16_t hi = (_envHigh + 255) >> 8;
+        const uint16_t minSpan = max(_autoRangeGate, (uint16_t)1);
+        if (hi - lo < minSpan)
+        {
+            // Noise gate: a quiet signal keeps the minimum span, from its low envelope
+            if (lo > 0xFFFF - minSpan)
+                lo = 0xFFFF - minSpan;
+            hi = lo + minSpan;
+        }
+
+        const uint16_t step = _segsNum ? max((uint16_t)((_maxMap - _minMap) / _segsNum), (uint16_t)1) : 1;
+        if (abs((int32_t)lo - _minMap) >= step || abs((int32_t)hi - _maxMap) >= step)
+        {
+            _minMap = lo;
+            _maxMap = hi;
+        }
+    }
+
+    // Closed-form (timeline) playback helpers
+    inline bool _isBounceAnim() const
+    {
+        return _currentFunc == &SBK_BarMeterAnimations::_bounceFill ||
+               _currentFunc == &SBK_BarMeterAnimations::_bounceFillHalfRangeMirrorCenter;
+    }
+    inline bool _isHalfRangeAnim() const
+    {
+        return _currentFunc == &SBK_BarMeterAnimations::_fillFromOrEmptyToCenter ||
+               _currentFunc == &SBK_BarMeterAnimations::_bounceFillHalfRangeMirrorCenter;
+    }
+    inline bool _isClosedFormAnim() const
+    {
+        return _currentFunc &&
+               (_currentFunc == &SBK_BarMeterAnimations::_fillOrEmpty || _isBounceAnim() || _isHalfRangeAnim());
+    }
+    // Closed-form range computed into locals: drawing a frame leaves the animation state untouched
+    void _closedFormRange(int8_t &minT, int8_t &maxT) const
+    {
+        minT = _minTracker;
+        maxT = _maxTracker;
+        if (!_usePtr)
+            return;
+        uint8_t minP = _sigPtr1 ? *_sigPtr1 : 0;
+        uint8_t maxP = _sigPtr2 ? *_sigPtr2 : 100;
+        _normalizePercentRange(minP, maxP);
+        const int8_t minR = _isHalfRangeAnim() ? (_segsNum / 2) - 1 : 0;
+        const uint8_t maxR = _isHalfRangeAnim() ? 0 : _segsNum - 1;
+        minT = map(minP, 0, 100, minR, maxR);
+        maxT = map(maxP, 0, 100, minR, maxR);
+    }
+
+    // Timebase elapsed time scaled by the speed, elapsed * |speed| / 100, kept in 32-bit math:
+    // advanced by the delta since the last update, resynced in closed form on attach, speed change, restart or a long gap
+    uint32_t _timebaseScaled()
+    {
+        const uint32_t elapsed = _timebase->elapsed(_currentTime);
+        const uint32_t speed = (uint32_t)abs(_speed);
+        const uint32_t delta = elapsed - _lastTimebaseElapsed;
+        if (!_timebaseSynced || _timebaseSpeed != _speed || delta > 0xFFFF)
+        {
+            // Split on 100 so no product exceeds 32 bits; wraps like the full product would
+            const uint32_t rem = (elapsed % 100) * speed;
+            _timebasePos = (elapsed / 100) * speed + rem / 100;
+            _timebaseFrac = rem % 100;
+            _timebaseSpeed = _speed;
+            _timebaseSynced = true;
+        }
+        else
+        {
+            const uint32_t acc = delta * speed + _timebaseFrac;
+            _timebasePos += acc / 100;
+            _timebaseFrac = acc % 100;
+        }
+        _lastTimebaseElapsed = elapsed;
+        return _timebasePos;
+    }
+
+    // Timeline position read from the shared timebase, then draw. Returns true when a non-looping timeline ends.
+    bool _updateFromTimebase()
+    {
+        const uint32_t dur = max((uint32_t)1, getDuration());
+        uint32_t pos = _timebaseScaled() + _phaseOffset;
+        bool ended = false;
+        if (_loop)
+            pos %= dur;
+        else if (pos >= dur)
+        {
+            pos = dur;
+            ended = true;
+        }
+        if (_speed < 0)
+            pos = dur - pos;
+        if (_loop && (_speed < 0 ? pos > _animTime : pos < _animTime))
+            _isLoopingNow = true;
+        _animTime = pos;
+        renderAt(pos);
+        return ended;
+    }
+
+    // Atomically apply pending = ((pending & ~clearMask) | setMask) ^ flipMask
+    void _postRequest(uint16_t clearMask, uint16_t setMask, uint16_t flipMask)
+    {
+#if defined(__AVR__)
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            _pendingReq = ((_pendingReq & ~clearMask) | setMask) ^ flipMask;
+        }
+#else
+        uint16_t cur = __atomic_load_n(&_pendingReq, __ATOMIC_RELAXED);
+        while (!__atomic_compare_exchange_n(&_pendingReq, &cur, (uint16_t)(((cur & ~clearMask) | setMask) ^ flipMask),
+                                            true, __ATOMIC_RELEASE, __ATOMIC_RELAXED))
+        {
+        }
+#endif
+    }
+
+    // Hot path check: a single load when nothing is pending
+    inline bool _hasPendingReq() const
+    {
+#if defined(__AVR__)
+        return _pendingReq != 0;
+#else
+        return __atomic_load_n(&_pendingReq, __ATOMIC_RELAXED) != 0;
+#endif
+    }
+
+    // Take every pending request at once and apply it with the regular setters
+    void _latchRequests()
+    {
+        uint16_t req;
+#if defined(__AVR__)
+        ATOMIC_BLOCK(ATOMIC_RESTORESTATE)
+        {
+            req = _pendingReq;
+            _pendingReq = 0;
+        }
+#else
+        req = __atomic_exchange_n(&_pendingReq, (uint16_t)0, __ATOMIC_ACQUIRE);
+#endif
+        if (req & REQ_SET_LOGIC)
+            setLogic(req & REQ_LOGIC_VALUE);
+        if (req & REQ_TOGGLE_LOGIC)
+            toggleLogic();
+        if (req & REQ_SET_DIR)
+            setDir(req & REQ_DIR_VALUE);
+        if (req & REQ_TOGGLE_DIR)
+            toggleDir();
+        if (req & REQ_PAUSE)
+            pause();
+        if (req & REQ_RESUME)
+            resume();
+        if (req & REQ_STOP_EMISSION)
+            stopBlockEmission();
+        if (req & REQ_RESUME_EMISSION)
+            resumeBlockEmission();
+        if (req & REQ_STOP)
+            stop();
+    }
+
+    // Time of the step being taken: now, or the last timebase grid instant when attached
+    inline uint32_t _stepTime(uint16_t intv) const
+    {
+        return _timebase ? _timebase->lastTick(intv, _phaseOffset, _currentTime) : _currentTime;
+    }
+
+    // Advance the virtual animation clock, then draw. Returns true when a non-looping timeline ends.
+    bool _updateTimeline()
+    {
+        if (_currentFunc != _timelineFunc)
+        {
+            // Another animation was started: restart the timeline
+            _timelineFunc = _currentFunc;
+            _animTime = 0;
+            _animTimeFrac = 0;
+            _timelineSynced = false;
+        }
+        if (!_timelineSynced)
+        {
+            _timelineSynced = true;
+            _lastTimelineUpdate = _currentTime;
+        }
+
+        const uint32_t dur = max((uint32_t)1, getDuration());
+        const uint32_t acc = (_currentTime - _lastTimelineUpdate) * (uint32_t)abs(_speed) + _animTimeFrac;
+        const uint32_t adv = acc / 100;
+        _animTimeFrac = acc % 100;
+        _lastTimelineUpdate = _currentTime;
+
+        bool ended = false;
+        if (_speed >= 0)
+        {
+            _animTime += adv;
+            if (_animTime >= dur)
+            {
+                if (_loop)
+                {
+                    _animTime %= dur;
+                    _isLoopingNow = true;
+                }
+                else
+                {
+                    _animTime = dur;
+                    ended = true;
+                }
+            }
+        }
+        else if (adv > _animTime)
+        {
+            if (_loop)
+            {
+                _animTime = dur - ((adv - _animTime) % dur);
+                _isLoopingNow = true;
+            }
+            else
+            {
+                _animTime = 0;
+                ended = true;
+            }
+        }
+        else
+            _animTime -= adv;
+
+        renderAt(_animTime);
+        return ended;
+    }
+
     // Animation update functions
 
     bool _setAllOn()
@@ -1599,7 +2617,7 @@ protected:
 
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
-            _lastUpdate1 = _currentTime;
+            _lastUpdate1 = _stepTime(_updateIntv1);
 
             if (_animRenderLogicIsInverted)
             {
@@ -1712,7 +2730,7 @@ protected:
 
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
-            _lastUpdate1 = _currentTime;
+            _lastUpdate1 = _stepTime(_updateIntv1);
             if (!_animRenderLogicIsInverted)
             {
                 if (_ledTracker1 >= _maxTracker && _ledTracker1 >= 0)
@@ -1809,7 +2827,7 @@ protected:
         // Update at bpm pulse
         if (_currentTime - lastBeat >= beat)
         {
-            lastBeat = _currentTime;
+            lastBeat = _stepTime(beat);
             isPeak = !isPeak; // Toggle between peak and base level
         }
 
@@ -1878,88 +2896,96 @@ protected:
 #define blockSpacing _param2
 #define requestedNumBlocks _param3
 #define maxBlocks _param4
-#define emitIndex _param5
+#define laneState _param5 // scrolling and mirror blocks
 #define emittedBlocksCount _counter1
 #define emitCooldown _counter2
-    void _emitBlock(int8_t pos)
-    {
-        if (!_blocks || maxBlocks < 1)
-            return;
-
-        if (emitCooldown > 0)
-        {
-            emitCooldown--;
-            return;
-        }
 
-        if (requestedNumBlocks > 0 && emittedBlocksCount >= requestedNumBlocks)
-            return;
+    // Bit lane helpers: multi-word bitsets, bit n in word n / 32
 
-        for (uint8_t i = 0; i < maxBlocks; ++i)
+    static inline bool _bitsAny(const uint32_t *w, uint16_t bits)
+    {
+        for (uint16_t n = 0; n < bits; n += 32)
         {
-            uint8_t idx = (emitIndex + i) % maxBlocks;
-            Block &b = _blocks[idx];
-
-            if (!b.active)
-            {
-                b.position = pos;
-                b.active = true;
-                emittedBlocksCount++;
-
-                emitCooldown = blockLength + blockSpacing - 1;
-                emitIndex = (emitIndex + 1) % maxBlocks;
-                return;
-            }
+            const uint8_t left = bits - n;
+            const uint32_t mask = left >= 32 ? 0xFFFFFFFFUL : ((1UL << left) - 1);
+            if (w[n >> 5] & mask)
+                return true;
         }
+        return false;
     }
 
-    static inline int8_t _calculateSwtichPostion(int8_t pos, uint8_t bockL, uint8_t range)
+    static inline uint8_t _bitsCount(const uint32_t *w, uint8_t words)
     {
-        // Compute switched block head position
-        return (range - 1) - pos + (bockL - 1);
+        uint8_t n = 0;
+        for (uint8_t i = 0; i < words; ++i)
+            n += __builtin_popcountl(w[i]);
+        return n;
     }
 
-    int8_t _calculateSwitchedEmitTickCounter(uint8_t range)
+    static inline int16_t _bitsLowest(const uint32_t *w, uint8_t words)
     {
-        const int8_t emitInterval = blockLength + blockSpacing;
-
-        int8_t closestSwp = -127; // Track the nearest visible block from new side
+        for (uint8_t i = 0; i < words; ++i)
+            if (w[i])
+                return (i << 5) + __builtin_ctzl(w[i]);
+        return -1;
+    }
 
-        for (uint8_t i = 0; i < maxBlocks; ++i)
+    // Move every bit one position up, bit 0 receives `in`, bits from `bits` up are dropped
+    static inline void _bitsShiftUp(uint32_t *w, uint8_t words, uint16_t bits, bool in)
+    {
+        uint32_t carry = in;
+        for (uint8_t i = 0; i < words; ++i)
         {
-            Block &b = _blocks[i];
-
-            if (!b.active)
-                continue;
-
-            int8_t p = b.position; // head position before switching
-
-            // Step 1: compute switched block head position
-            int8_t swp = _calculateSwtichPostion(p, blockLength, range);
-
-            b.position = swp;
+            const uint32_t old = w[i];
+            w[i] = (old << 1) | carry;
+            carry = old >> 31;
+        }
+        if (words && (bits & 31))
+            w[words - 1] &= (1UL << (bits & 31)) - 1;
+    }
 
-            // Step 2: if out of visible range, deactivate block
-            if (swp < 0)
+    // Mirror bits 0 to bits - 1 (bit n moves to bits - 1 - n)
+    static void _bitsReverse(uint32_t *w, uint16_t bits)
+    {
+        for (uint16_t lo = 0, hi = bits - 1; bits && lo < hi; ++lo, --hi)
+        {
+            const bool a = (w[lo >> 5] >> (lo & 31)) & 1;
+            const bool b = (w[hi >> 5] >> (hi & 31)) & 1;
+            if (a != b)
             {
-                b.active = false;
-                continue;
+                w[lo >> 5] ^= 1UL << (lo & 31);
+                w[hi >> 5] ^= 1UL << (hi & 31);
             }
-
-            // // Step 3: Keep the first (closest to emit side) visible block
-            if (closestSwp == -127 || swp < closestSwp)
-                closestSwp = swp;
         }
+    }
+
+    int8_t _calculateSwitchedEmitTickCounter(const uint32_t *heads, uint8_t headWords)
+    {
+        const int8_t emitInterval = blockLength + blockSpacing;
+
+        // Nearest block head from the new emit side, heads already switched
+        const int16_t closestSwp = _bitsLowest(heads, headWords);
 
         if (closestSwp >= 0)
-            return (emitInterval - 1) - closestSwp;
+            return (emitInterval - 1) - (int8_t)closestSwp;
         else
             return 0; // fallback if no visible block found
     }
 
-    bool _mirrorBlocks()
+    /**
+     * Scrolling and mirror block engine.
+     *
+     * Blocks move along a range of `range` pixels as two bit lanes, pixel lane first:
+     * - pixels: bit q set if lane pixel q is lit (q = 0 at the emit end)
+     * - heads:  bit h set for a block head at position h, up to range + blockLength - 2
+     * Each tick shifts both lanes one bit up; a pixel enters the lane while a head is within the
+     * first blockLength positions. Only the pixels that changed are written to the bar.
+     */
+    bool _blockLanes(uint8_t range, bool mirror)
     {
-        const uint8_t center = _segsNum / 2;
+        const uint8_t pixWords = (range + 31) >> 5;
+        const uint16_t headBits = (range + blockLength) ? range + blockLength - 1 : 0;
+        const uint8_t headWords = (headBits + 31) >> 5;
 
         if (_init)
         {
@@ -1968,179 +2994,209 @@ protected:
 
             emittedBlocksCount = 0;
             emitCooldown = 0;
+            laneState = 0;
 
             if (!_animLogicSet)
                 _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
 
-            if (_blocks)
-            {
-                delete[] _blocks;
-                _blocks = nullptr;
-            }
-            _blocks = new Block[maxBlocks]{};
-            return false;
+            return !_allocLanes(pixWords + headWords); // no room: the animation ends at once
         }
 
+        if (!_laneWords)
+            return true;
+        uint32_t *pix = _laneWords;
+        uint32_t *heads = _laneWords + pixWords;
+
         if (_prevAnimRenderLogic != _animRenderLogicIsInverted)
         {
-            emitCooldown = _calculateSwitchedEmitTickCounter(_segsNum / 2);
+            // Motion reversed: mirror both lanes, the bar keeps its look
+            _bitsReverse(pix, range);
+            _bitsReverse(heads, headBits);
+            emitCooldown = _calculateSwitchedEmitTickCounter(heads, headWords);
             emittedBlocksCount = requestedNumBlocks;
             _prevAnimRenderLogic = _animRenderLogicIsInverted;
         }
 
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
-            _lastUpdate1 = _currentTime;
-            // _frameCounter++;
-            _barMeter.clear();
+            _lastUpdate1 = _stepTime(_updateIntv1);
 
+            // Emit at head position 0, at most maxBlocks blocks alive
+            bool emit = false;
             if ((requestedNumBlocks == 0 || emittedBlocksCount < requestedNumBlocks) && _emittingBlocksEnabled)
-                _emitBlock(-1); // Because the new block will move to 0 postion in first iteration
-
-            for (uint8_t i = 0; i < maxBlocks; ++i)
             {
-                Block &b = _blocks[i];
-                if (!b.active)
-                    continue;
-
-                b.position++;
-
-                // Only render to lower half (0 to _centerTracker - 1)
-                uint16_t clamped = max(0, (int16_t)b.position + 1);
-                uint8_t pixelsVisible = min(blockLength, (uint8_t)clamped);
-                for (uint8_t j = 0; j < pixelsVisible; ++j)
+                if (emitCooldown > 0)
+                    emitCooldown--;
+                else if (_bitsCount(heads, headWords) < maxBlocks)
                 {
-                    int8_t pos = _animRenderLogicIsInverted ? center - 1 - b.position : b.position;
-                    int8_t tailOffset = _animRenderLogicIsInverted ? pos + j : pos - j;
-
-                    if (tailOffset < 0)
-                        continue;
-
-                    int8_t idx = tailOffset;
-                    if (idx >= center)
-                        continue;
-
-                    int8_t mirrorIdx = _segsNum - 1 - idx;
-
-                    if (idx >= 0 && idx < _segsNum)
-                    {
-                        _barMeter.setPixel(idx, true);
-                    }
-                    if (mirrorIdx != idx && mirrorIdx >= 0 && mirrorIdx < _segsNum)
-                    {
-                        _barMeter.setPixel(mirrorIdx, true);
-                    }
+                    emit = true;
+                    emittedBlocksCount++;
+                    emitCooldown = blockLength + blockSpacing - 1;
                 }
-
-                // Deactivate block if head has passed the visual range
-                if (b.position >= center - 1 + blockLength)
-                    b.active = false;
             }
+
+            _bitsShiftUp(heads, headWords, headBits, emit);
+            _shiftPixelLane(pix, pixWords, range, _bitsAny(heads, min((uint16_t)blockLength, headBits)), mirror);
         }
+
         // animation as ended if emmit is disable and all blocks are cleared
         if ((requestedNumBlocks > 0 && emittedBlocksCount >= requestedNumBlocks) || !_emittingBlocksEnabled)
+            return !_bitsAny(heads, headBits);
+
+        return false;
+    }
+
+    void _shiftPixelLane(uint32_t *pix, uint8_t words, uint8_t range, bool in, bool mirror)
+    {
+        // Redraw everything on the first tick, or if the bar direction changed
+        const uint8_t state = LANE_DRAWN | (!mirror && _animRenderDirIsReversed ? LANE_REVERSED : 0);
+        const bool redraw = laneState != state;
+        if (redraw)
         {
-            bool anyActive = false;
-            for (uint8_t i = 0; i < maxBlocks; ++i)
+            _barMeter.clear();
+            laneState = state;
+        }
+
+        uint32_t carry = in;
+        for (uint8_t w = 0; w < words; ++w)
+        {
+            const uint32_t old = pix[w];
+            uint32_t now = (old << 1) | carry;
+            carry = old >> 31;
+            if (w == words - 1 && (range & 31))
+                now &= (1UL << (range & 31)) - 1;
+            pix[w] = now;
+
+            uint32_t diff = redraw ? now : old ^ now;
+            while (diff)
             {
-                if (_blocks[i].active)
+                const uint8_t b = __builtin_ctzl(diff);
+                diff &= diff - 1;
+                const uint8_t q = (w << 5) + b;
+                const uint8_t idx = _animRenderLogicIsInverted ? range - 1 - q : q;
+                const bool on = (now >> b) & 1;
+                if (mirror)
                 {
-                    anyActive = true;
-                    break;
+                    _barMeter.setPixel(idx, on);
+                    _barMeter.setPixel(_segsNum - 1 - idx, on);
                 }
+                else
+                    _barMeter.setPixel(_corrPixelToDir(idx), on);
             }
-            if (!anyActive)
-                return true; // animation complete
         }
-
-        return false;
     }
 
-    bool _scrollingBlocks()
+    bool _mirrorBlocks() { return _blockLanes(_segsNum / 2, true); }
+
+    bool _scrollingBlocks() { return _blockLanes(_segsNum, false); }
+
+#define patternState _sequenceState
+    /*
+     * Segment idx shows pattern bit (idx - pos) mod patternBits, pos being the ring offset.
+     * A step moves pos by one, up or down with the logic; each 32-segment word of the bar is the
+     * pattern read as a rotated window, and only the bits differing from the previous offset are written.
+     */
+    bool _scrollPattern()
     {
         if (_init)
         {
             _init = false;
-            _emittingBlocksEnabled = true;
-
-            emittedBlocksCount = 0;
-            emitCooldown = 0;
-
+            _patternPos = 0;
+            patternState = 0;
             if (!_animLogicSet)
-                _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
-
-            if (_blocks)
-            {
-                delete[] _blocks;
-                _blocks = nullptr;
-            }
-            _blocks = new Block[maxBlocks]{};
+                _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
+            if (!_pattern || !_patternBits)
+                return true;
+            _lastUpdate1 = _stepTime(_updateIntv1);
+            _patternDraw(0); // first frame right away
             return false;
         }
 
-        if (_prevAnimRenderLogic != _animRenderLogicIsInverted)
-        {
-            emitCooldown = _calculateSwitchedEmitTickCounter(_segsNum);
-            emittedBlocksCount = requestedNumBlocks;
-            _prevAnimRenderLogic = _animRenderLogicIsInverted;
-        }
-
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
-            _lastUpdate1 = _currentTime;
-            _setAllOff();
+            _lastUpdate1 = _stepTime(_updateIntv1);
+            const uint16_t prevPos = _patternPos;
+            if (!_animRenderLogicIsInverted)
+                _patternPos = _patternPos + 1 < _patternBits ? _patternPos + 1 : 0;
+            else
+                _patternPos = _patternPos ? _patternPos - 1 : _patternBits - 1;
+            _patternDraw(prevPos);
+        }
+        else if (patternState != (LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0)))
+            _patternDraw(_patternPos); // bar direction changed: redraw now
 
-            if ((requestedNumBlocks == 0 || emittedBlocksCount < requestedNumBlocks) && _emittingBlocksEnabled)
-                _emitBlock(-1); // Start fully off-screen left
+        return false;
+    }
 
-            for (uint8_t i = 0; i < maxBlocks; ++i)
+    // Write the segments that differ between ring offsets prevPos and _patternPos
+    void _patternDraw(uint16_t prevPos)
+    {
+        // Redraw everything on the first frame, or if the bar direction changed
+        const uint8_t state = LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0);
+        const bool redraw = patternState != state;
+        patternState = state;
+
+        const uint16_t len = _patternBits;
+        const uint16_t wrap = 32 % len;
+        uint16_t now = _patternPos ? len - _patternPos : 0; // pattern bit shown by segment 0
+        uint16_t prev = prevPos ? len - prevPos : 0;
+        const uint8_t words = (_segsNum + 31) >> 5;
+        for (uint8_t w = 0; w < words; ++w)
+        {
+            const uint32_t bits = _patternWindow(now);
+            uint32_t diff = redraw ? 0xFFFFFFFFUL : (now == prev ? 0 : bits ^ _patternWindow(prev));
+            if (w == words - 1 && (_segsNum & 31))
+                diff &= (1UL << (_segsNum & 31)) - 1;
+            while (diff)
             {
-                Block &b = _blocks[i];
-                if (!b.active)
-                    continue;
-
-                b.position++;
-
-                for (uint8_t j = 0; j < blockLength; ++j)
-                {
-                    int8_t pos = _animRenderLogicIsInverted ? (_segsNum - 1) - b.position : b.position;
-                    int8_t tailOffset = _animRenderLogicIsInverted ? pos + j : pos - j;
-
-                    if (tailOffset < 0)
-                        continue;
-
-                    int8_t idx = tailOffset;
-                    if (idx >= _segsNum)
-                        continue;
-
-                    if (idx >= 0 && idx < _segsNum)
-                        _barMeter.setPixel(_corrPixelToDir(idx), true);
-                }
-
-                // Deactivate block if head has passed the visual range
-                if (b.position >= (_segsNum - 1) + blockLength)
-                    b.active = false;
+                const uint8_t b = __builtin_ctzl(diff);
+                diff &= diff - 1;
+                _barMeter.setPixel(_corrPixelToDir((w << 5) + b), (bits >> b) & 1);
             }
+            now = now + wrap < len ? now + wrap : now + wrap - len;
+            prev = prev + wrap < len ? prev + wrap : prev + wrap - len;
         }
+    }
 
-        if ((requestedNumBlocks > 0 && emittedBlocksCount >= requestedNumBlocks) || !_emittingBlocksEnabled)
+    // 32 pattern bits from bit `start`, wrapping around the pattern end
+    uint32_t _patternWindow(uint16_t start) const
+    {
+        uint32_t bits = 0;
+        uint8_t filled = 0;
+        while (filled < 32)
         {
-            for (uint8_t i = 0; i < maxBlocks; ++i)
-            {
-                if (_blocks[i].active)
-                    return false;
-            }
-            return true;
+            const uint8_t shift = start & 7;
+            uint16_t take = 8 - shift;
+            if (take > _patternBits - start)
+                take = _patternBits - start;
+            if (take > 32U - filled)
+                take = 32U - filled;
+            const uint8_t byte = _patternProgmem ? pgm_read_byte(_pattern + (start >> 3)) : _pattern[start >> 3];
+            bits |= (uint32_t)((byte >> shift) & ((1U << take) - 1)) << filled;
+            filled += take;
+            start += take;
+            if (start >= _patternBits)
+                start = 0;
         }
-
-        return false;
+        return bits;
     }
+#undef patternState
 
 #define stackLevel _ledTracker1
+#define headPos _ledTracker2
+#define drawnLevel _ledTracker3
+#define headActive _param3
+#define headDrawn _counter2
+#define stackState _sequenceState
+    /*
+     * Stack level plus one moving head block. The stack shows the periodic block pattern below
+     * stackLevel - blockInterval; the head is the only block in flight. Each tick writes the head
+     * pixels, then restores the pattern where the head crossed the stack and where the stack grew,
+     * so the work per tick does not depend on the bar length.
+     */
     bool _stackingBlocks()
     {
         const uint8_t blockInterval = blockLength + blockSpacing;
-        bool hasActive = false; // active block tracker
 
         if (_init)
         {
@@ -2149,37 +3205,20 @@ protected:
             if (!_animLogicSet)
                 _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
 
-            maxBlocks = 1;
-            if (_blocks)
-            {
-                delete[] _blocks;
-                _blocks = nullptr;
-            }
-            _blocks = new Block[maxBlocks]{};
-
-            emitIndex = 0;
-            emitCooldown = 0;
-
+            _freeAnimMemory();
+            headActive = false;
             stackLevel = 0;
             if (!_animRenderLogicIsInverted)
-            {
-                _barMeter.clear();
-                // Falling blocks
-                // stackLevel = 0;
-            }
+                _barMeter.clear(); // Falling blocks
             else
             {
                 // Flying upward - fill pattern first
                 while (stackLevel < _segsNum)
                     stackLevel += blockInterval;
-                for (uint8_t i = 0; i < stackLevel; i++)
-                {
-                    if ((i % blockInterval) < blockLength)
-                        _barMeter.setPixel(_corrPixelToDir(i), true);
-                    else
-                        _barMeter.setPixel(_corrPixelToDir(i), false);
-                }
+                _stackPattern(0, stackLevel);
             }
+            drawnLevel = stackLevel;
+            stackState = LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0);
 
             return false;
         }
@@ -2193,130 +3232,347 @@ protected:
                 stackLevel -= blockInterval;
         }
 
+        if (stackState != (LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0)))
+            _stackMirror(); // bar direction changed
+
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
-            _lastUpdate1 = _currentTime;
+            _lastUpdate1 = _stepTime(_updateIntv1);
 
-            // Only clear pixels of active blocks, not the whole bar
-            for (uint8_t i = 0; i < maxBlocks; ++i)
+            // Emit a head if none in flight
+            const bool hadHead = headActive;
+            if (!headActive)
             {
-                Block &b = _blocks[i];
-                if (!b.active)
-                    continue;
-
-                for (uint8_t j = 0; j < blockLength; ++j)
+                headDrawn = false;
+                if (!_animRenderLogicIsInverted && stackLevel <= _segsNum)
                 {
-                    int8_t seg = b.position + j;
-                    if (seg >= 0 && seg < _segsNum)
-                        _barMeter.setPixel(_corrPixelToDir(seg), false);
+                    headPos = _segsNum; // fall from top
+                    headActive = true;
                 }
-            }
-
-            // Emit one block if none active
-            for (uint8_t i = 0; i < maxBlocks; ++i)
-            {
-                if (_blocks[i].active)
+                else if (_animRenderLogicIsInverted && stackLevel >= 0)
                 {
-                    hasActive = true;
-                    break;
+                    headPos = stackLevel - blockInterval;
+                    headActive = true;
                 }
             }
-            if (!hasActive)
-            {
-                emitCooldown = 0; // emit blocks on demand
-                if (!_animRenderLogicIsInverted && stackLevel <= _segsNum)
-                    _emitBlock(_segsNum); // fall from top
-                else if (_animRenderLogicIsInverted && stackLevel >= 0)
-                    _emitBlock(stackLevel - blockInterval);
-            }
 
-            // Update and draw all active blocks
-            for (uint8_t i = 0; i < maxBlocks; ++i)
+            // Move the head one segment, land it on the stack or let it fly out
+            int16_t crossedFrom = 0, crossedTo = 0;
+            if (headActive)
             {
-                Block &b = _blocks[i];
-                if (!b.active)
-                    continue;
-
-                // Clear trailing pixel of previous frame
-                int8_t clearPos = b.position;
-                if (clearPos >= 0 && clearPos < _segsNum)
-                    _barMeter.setPixel(_corrPixelToDir(clearPos), false);
-
-                // Move block
-                if (!_animRenderLogicIsInverted)
-                    b.position--;
+                const int8_t from = headPos;
+                headPos += _animRenderLogicIsInverted ? 1 : -1;
+                if (!headDrawn)
+                {
+                    // Just emitted, or partly overwritten: draw the whole block
+                    _stackHead(from, false);
+                    _stackPixel(from, false);
+                    _stackHead(headPos, true);
+                }
+                else if (headPos < from)
+                {
+                    // Moving down: clear the old top, light the new bottom
+                    _stackPixel(from + blockLength - 1, false);
+                    _stackPixel(headPos, true);
+                }
                 else
-                    b.position++;
-
-                for (uint8_t j = 0; j < blockLength; ++j)
                 {
-                    int8_t seg = b.position + j;
-                    if (seg >= 0 && seg < _segsNum)
-                        _barMeter.setPixel(_corrPixelToDir(seg), true);
+                    // Moving up: clear the old bottom, light the new top
+                    _stackPixel(from, false);
+                    _stackPixel(headPos + blockLength - 1, true);
                 }
+                crossedFrom = min(from, headPos);
+                crossedTo = max(from, headPos) + blockLength;
 
-                if (!_animRenderLogicIsInverted)
+                if (!_animRenderLogicIsInverted && headPos <= stackLevel)
                 {
-                    if (b.position <= stackLevel)
-                    {
-                        stackLevel += blockInterval;
-                        b.active = false;
-                    }
+                    stackLevel += blockInterval;
+                    headActive = false;
                 }
-                else
+                else if (_animRenderLogicIsInverted && headPos >= _segsNum)
                 {
-                    if (b.position >= _segsNum)
-                    {
-                        stackLevel -= blockInterval;
-                        b.active = false;
-                    }
+                    stackLevel -= blockInterval;
+                    headActive = false;
                 }
             }
 
             // Draw base for stacking
             if (stackLevel == 0)
-            {
                 _barMeter.setPixel(_corrPixelToDir(0), false);
-            }
+
+            // Restore the pattern below the stack top: new stack rows, then what the head crossed
+            const int16_t patternTop = stackLevel - blockInterval;
+            if (patternTop > drawnLevel)
+                _stackPattern(drawnLevel, patternTop);
+            drawnLevel = max(patternTop, (int16_t)-1);
+            _stackPattern(crossedFrom, min(crossedTo, patternTop));
+
+            // The next move only writes two pixels if the head is still drawn whole
+            headDrawn = headActive && crossedFrom >= max(patternTop, (int16_t)0) && (stackLevel != 0 || headPos > 0);
+
             if (!_animRenderLogicIsInverted)
             {
-                for (int8_t i = 0; i < stackLevel - blockInterval; ++i)
-                {
-                    if ((i % blockInterval) < blockLength)
-                        _barMeter.setPixel(_corrPixelToDir(i), true);
-                    else
-                        _barMeter.setPixel(_corrPixelToDir(i), false);
-                }
+                if (stackLevel >= _segsNum - 1 && !hadHead)
+                    return true;
             }
             else
             {
-                for (uint8_t i = 0; i < stackLevel - blockInterval; i++)
+                if (stackLevel <= 0 && !hadHead)
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    // Draw or clear the head block at pos
+    void _stackHead(int16_t pos, bool on)
+    {
+        for (int16_t seg = max(pos, (int16_t)0); seg < pos + blockLength && seg < _segsNum; ++seg)
+            _barMeter.setPixel(_corrPixelToDir(seg), on);
+    }
+
+    inline void _stackPixel(int16_t seg, bool on)
+    {
+        if (seg >= 0 && seg < _segsNum)
+            _barMeter.setPixel(_corrPixelToDir(seg), on);
+    }
+
+    // Draw the stack pattern over segments [from, to): blockLength lit, blockSpacing off, repeated
+    void _stackPattern(int16_t from, int16_t to)
+    {
+        const uint8_t blockInterval = blockLength + blockSpacing;
+        if (from < 0)
+            from = 0;
+        if (to > _segsNum)
+            to = _segsNum;
+        if (from >= to)
+            return;
+        uint8_t phase = from % blockInterval;
+        for (int16_t seg = from; seg < to; ++seg)
+        {
+            _barMeter.setPixel(_corrPixelToDir(seg), phase < blockLength);
+            if (++phase == blockInterval)
+                phase = 0;
+        }
+    }
+
+    // Mirror the bar contents after a bar direction change: the animation keeps its look
+    void _stackMirror()
+    {
+        for (uint8_t i = 0, j = _segsNum ? _segsNum - 1 : 0; i < j; ++i, --j)
+        {
+            const bool low = _barMeter.getPixelState(i);
+            _barMeter.setPixel(i, _barMeter.getPixelState(j));
+            _barMeter.setPixel(j, low);
+        }
+        stackState = LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0);
+    }
+#undef stackLevel
+#undef headPos
+#undef drawnLevel
+#undef headActive
+#undef headDrawn
+#undef stackState
+
+#define particleGravity _param1
+#define particleBounce _param2
+#define particleStacking _param3
+#define particlesNum _param4
+#define particleState _sequenceState
+#define spawnCooldown _counter2
+#define particleStack _smoothedValue1
+#define launchSpeed _smoothedValue2
+    /*
+     * Particles move along the bar in Q8.8 fixed point: position above the bottom, velocity in
+     * segments per tick. Each tick integrates every particle with integer math only, builds the
+     * frame as a bitset and writes the segments that differ from the previous frame in one pass.
+     */
+    bool _particlePhysics()
+    {
+        if (_init)
+        {
+            _init = false;
+
+            if (!_animLogicSet || particleStacking)
+                _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
+
+            particlesNum = _allocParticles(particlesNum);
+            particleState = 0;
+            particleStack = 0;
+            spawnCooldown = 0;
+
+            // Speed reaching the top from the bottom: v² = 2·g·h
+            launchSpeed = _isqrt((uint32_t)2 * particleGravity * ((uint32_t)(_segsNum ? _segsNum - 1 : 0) << 8));
+            if (!particleStacking)
+                for (uint8_t i = 0; i < particlesNum; ++i)
+                    _particleLaunch(_particles[i], 0);
+
+            return !particlesNum || !_segsNum; // no room: the animation ends at once
+        }
+
+        if (!_particles)
+            return true;
+
+        const int32_t top = (int32_t)(_segsNum - 1) << 8;
+        if (_prevAnimRenderLogic != _animRenderLogicIsInverted)
+        {
+            // Gravity flipped: mirror the particles, the bar keeps its look
+            for (uint8_t i = 0; i < particlesNum; ++i)
+            {
+                _particles[i].pos = (uint16_t)(top - _particles[i].pos);
+                _particles[i].vel = -_particles[i].vel;
+            }
+            _prevAnimRenderLogic = _animRenderLogicIsInverted;
+            _particlesRender();
+        }
+
+        if (_currentTime - _lastUpdate1 >= _updateIntv1)
+        {
+            _lastUpdate1 = _stepTime(_updateIntv1);
+
+            uint8_t flying = 0;
+            for (uint8_t i = 0; i < particlesNum; ++i)
+            {
+                Particle &p = _particles[i];
+                if (!p.active)
+                    continue;
+
+                const int32_t bottom = (int32_t)particleStack << 8;
+                int32_t vel = p.vel - particleGravity;
+                int32_t pos = p.pos + vel;
+                if (pos <= bottom)
                 {
-                    if ((i % blockInterval) < blockLength)
-                        _barMeter.setPixel(_corrPixelToDir(i), true);
-                    else
-                        _barMeter.setPixel(_corrPixelToDir(i), false);
+                    pos = bottom;
+                    vel = (-vel * particleBounce) >> 8;
+                    if (vel * vel < (int32_t)particleGravity << 8) // would not rise half a segment
+                    {
+                        if (particleStacking)
+                        {
+                            p.active = false;
+                            particleStack++;
+                            continue;
+                        }
+                        vel = _particleSpeed();
+                    }
+                }
+                else if (pos > top)
+                {
+                    pos = top;
+                    vel = (-vel * particleBounce) >> 8;
                 }
+                p.pos = (uint16_t)pos;
+                p.vel = (int16_t)vel;
+                flying++;
             }
-            if (!_animRenderLogicIsInverted)
+
+            // Stacking: drop a new particle from the top now and then, while there is room left
+            if (particleStacking && particleStack + flying < _segsNum)
             {
-                if (stackLevel >= _segsNum - 1 && !hasActive)
-                    return true;
+                if (spawnCooldown > 0)
+                    spawnCooldown--;
+                else
+                    for (uint8_t i = 0; i < particlesNum; ++i)
+                        if (!_particles[i].active)
+                        {
+                            _particleLaunch(_particles[i], top);
+                            spawnCooldown = random(6, 20);
+                            break;
+                        }
             }
-            else
+
+            _particlesRender();
+
+            if (particleStacking && particleStack >= _segsNum)
+                return true; // bar full
+        }
+        else if (particleState != (LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0)))
+            _particlesRender(); // first frame, or bar direction changed: redraw now
+        return false;
+    }
+
+    void _particleLaunch(Particle &p, int32_t pos)
+    {
+        p.pos = (uint16_t)pos;
+        p.vel = pos ? 0 : _particleSpeed();
+        p.active = true;
+    }
+
+    // Random launch speed, reaching a quarter to all of the bar height
+    int16_t _particleSpeed() { return (int16_t)random(launchSpeed / 2, launchSpeed + 1); }
+
+    void _particlesRender()
+    {
+        // Build the frame: stack, then particles at their nearest segment
+        uint32_t frame[8];
+        const uint8_t words = (_segsNum + 31) >> 5;
+        for (uint8_t w = 0; w < words; ++w)
+        {
+            const int16_t fill = (int16_t)particleStack - (w << 5);
+            frame[w] = fill >= 32 ? 0xFFFFFFFFUL : (fill > 0 ? (1UL << fill) - 1 : 0);
+        }
+        for (uint8_t i = 0; i < particlesNum; ++i)
+        {
+            const Particle &p = _particles[i];
+            if (!p.active)
+                continue;
+            uint8_t q = min((uint16_t)((p.pos + 128) >> 8), (uint16_t)(_segsNum - 1));
+            if (_animRenderLogicIsInverted)
+                q = _segsNum - 1 - q;
+            frame[q >> 5] |= 1UL << (q & 31);
+        }
+
+        // Redraw everything on the first frame, or if the bar direction changed
+        const uint8_t state = LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0);
+        const bool redraw = particleState != state;
+        particleState = state;
+
+        for (uint8_t w = 0; w < words; ++w)
+        {
+            uint32_t diff = redraw ? 0xFFFFFFFFUL : frame[w] ^ _laneWords[w];
+            if (w == words - 1 && (_segsNum & 31))
+                diff &= (1UL << (_segsNum & 31)) - 1;
+            _laneWords[w] = frame[w];
+            while (diff)
             {
-                if (stackLevel <= 0 && !hasActive)
-                    return true;
+                const uint8_t b = __builtin_ctzl(diff);
+                diff &= diff - 1;
+                _barMeter.setPixel(_corrPixelToDir((w << 5) + b), (frame[w] >> b) & 1);
             }
         }
-        return false;
     }
-#undef stackLevel
+
+    static uint16_t _isqrt(uint32_t n)
+    {
+        uint32_t root = 0;
+        uint32_t bit = 1UL << 30;
+        while (bit > n)
+            bit >>= 2;
+        while (bit)
+        {
+            if (n >= root + bit)
+            {
+                n -= root + bit;
+                root = (root >> 1) + bit;
+            }
+            else
+                root >>= 1;
+            bit >>= 2;
+        }
+        return (uint16_t)root;
+    }
+#undef particleGravity
+#undef particleBounce
+#undef particleStacking
+#undef particlesNum
+#undef particleState
+#undef spawnCooldown
+#undef particleStack
+#undef launchSpeed
 #undef blockLength
 #undef blockSpacing
 #undef requestedNumBlocks
 #undef maxBlocks
-#undef emitIndex
+#undef laneState
 #undef emittedBlocksCount
 #undef emitCooldown
 
@@ -2337,6 +3593,8 @@ protected:
                 _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
 
             _smoothedValue1 = *_sigPtr1;
+            if (_autoRange)
+                _autoRangeInit();
             _lastUpdate1 = _currentTime;
             _setAllOff();
             return false;
@@ -2347,6 +3605,8 @@ protected:
         {
             uint16_t raw = *_sigPtr1;
             _smoothedValue1 = (raw * smoothingFactor + _smoothedValue1 * (100 - smoothingFactor)) / 100;
+            if (_autoRange)
+                _autoRangeSample(_smoothedValue1);
             _lastUpdate2 = _currentTime;
         }
 
@@ -2379,6 +3639,8 @@ protected:
                 _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
 
             _smoothedValue1 = *_sigPtr1;
+            if (_autoRange)
+                _autoRangeInit();
             _lastUpdate1 = _currentTime;
             _setAllOff();
             return false;
@@ -2389,6 +3651,8 @@ protected:
         {
             uint16_t raw = *_sigPtr1;
             _smoothedValue1 = (raw * smoothingFactor + _smoothedValue1 * (100 - smoothingFactor)) / 100;
+            if (_autoRange)
+                _autoRangeSample(_smoothedValue1);
             _lastUpdate2 = _currentTime;
         }
 
@@ -2433,6 +3697,8 @@ protected:
                 _mirrorHalfRangeDir = _prevAnimRenderLogic = _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
 
             _smoothedValue1 = *_sigPtr1;
+            if (_autoRange)
+                _autoRangeInit();
             if (_sigPtr2)
                 _smoothedValue2 = *_sigPtr2;
             _lastUpdate1 = _currentTime;
@@ -2455,7 +3721,11 @@ protected:
             {
                 uint16_t raw2 = *_sigPtr2;
                 _smoothedValue2 = (uint16_t)(((uint32_t)smoothingFactor * raw2 + (uint32_t)(100 - smoothingFactor) * _smoothedValue2) / 100);
+                if (_autoRange) // both halves share one range, sampled once per interval
+                    _autoRangeSample(min(_smoothedValue1, _smoothedValue2), max(_smoothedValue1, _smoothedValue2));
             }
+            else if (_autoRange)
+                _autoRangeSample(_smoothedValue1);
         }
 
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
@@ -2506,6 +3776,8 @@ protected:
 
             _setAllOff();
             _smoothedValue1 = *_sigPtr1;
+            if (_autoRange)
+                _autoRangeInit();
             lastBaseUpdate = _currentTime;
             lastPeakUpdate = _currentTime;
             currentLevel = 0;
@@ -2520,6 +3792,8 @@ protected:
 
             uint16_t raw = *_sigPtr1;
             _smoothedValue1 = (raw * smoothingFactor + _smoothedValue1 * (100 - smoothingFactor)) / 100;
+            if (_autoRange)
+                _autoRangeSample(_smoothedValue1);
             currentLevel = _getMappedSignal(_smoothedValue1, _minMap, _maxMap, 0, _segsNum);
         }
 
@@ -2566,9 +3840,6 @@ protected:
 #define cursor _ledTracker1
     bool _randomPixelUpdater()
     {
-
-        static uint8_t *pixelOrder = nullptr;
-
         if (_init)
         {
             _init = false;
@@ -2581,22 +3852,17 @@ protected:
             else
                 _setAllOff();
 
-            if (pixelOrder)
-            {
-                delete[] pixelOrder;
-                pixelOrder = nullptr;
-            }
-
-            pixelOrder = new uint8_t[_segsNum];
-            for (uint8_t i = 0; i < _segsNum; ++i)
-                pixelOrder[i] = i;
+            // Shuffled order of the first n segments, the others follow in sequence
+            const uint8_t n = _allocPixelOrder();
+            for (uint8_t i = 0; i < n; ++i)
+                _pixelOrder[i] = i;
 
-            for (uint8_t i = _segsNum - 1; i > 0; --i)
+            for (uint8_t i = n > 1 ? n - 1 : 0; i > 0; --i)
             {
                 uint8_t j = random(0, i + 1);
-                uint8_t tmp = pixelOrder[i];
-                pixelOrder[i] = pixelOrder[j];
-                pixelOrder[j] = tmp;
+                uint8_t tmp = _pixelOrder[i];
+                _pixelOrder[i] = _pixelOrder[j];
+                _pixelOrder[j] = tmp;
             }
 
             cursor = 0;
@@ -2605,6 +3871,9 @@ protected:
             return false;
         }
 
+        if (!_pixelOrder)
+            return true;
+
         if (_currentTime - _lastUpdate1 >= _updateIntv1)
         {
             _lastUpdate1 = _currentTime;
@@ -2612,7 +3881,7 @@ protected:
             uint8_t retries = 0;
             while (cursor < _segsNum && retries++ < _segsNum - 1)
             {
-                uint8_t seg = pixelOrder[cursor];
+                uint8_t seg = cursor < PIXEL_ORDER_CAP ? _pixelOrder[cursor] : cursor;
                 bool currentState = _barMeter.getPixelState(seg);
                 bool shouldChange = (!_AnimInitLogicIsInverted && !currentState) || (_AnimInitLogicIsInverted && currentState);
 
@@ -2630,11 +3899,326 @@ protected:
         }
         if (cursor >= _segsNum)
         {
-            delete[] pixelOrder;
-            pixelOrder = nullptr;
+            _freeAnimMemory();
             return true;
         }
         return false;
     }
 #undef cursor
+
+#define clipRepeat _counter1
+#define clipState _sequenceState
+    bool _playClip()
+    {
+        if (_init)
+        {
+            _init = false;
+            if (!_animLogicSet)
+                _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
+            _clipPos = 0;
+            _clipFrame = 0;
+            _clipPrev = 0xFFFF;
+            clipState = 0;
+            clipRepeat = 0;
+            _lastUpdate1 = _stepTime(_updateIntv1);
+            _clipStep(); // first frame right away
+            return false;
+        }
+
+        if (_currentTime - _lastUpdate1 >= _updateIntv1)
+        {
+            _lastUpdate1 = _stepTime(_updateIntv1);
+            if (!_clipStep())
+                return true; // clip done
+        }
+        return false;
+    }
+
+    // Show the next clip frame. Returns false past the last frame.
+    bool _clipStep()
+    {
+        if (!_clip.data || _clipFrame >= _clip.framesNum)
+            return false;
+        const uint8_t n = _clip.frameBytes();
+        if (_clip.flags & SBK_BarClip::RLE)
+        {
+            if (!clipRepeat)
+            {
+                // New record: repeat count, then the frame drawn once for all its ticks
+                clipRepeat = _clip.byteAt(_clipPos);
+                _clipDraw(_clipPos + 1);
+            }
+            if (!clipRepeat || !--clipRepeat)
+                _clipPos += 1 + n;
+        }
+        else
+        {
+            _clipDraw(_clipPos);
+            _clipPos += n;
+        }
+        ++_clipFrame;
+        return true;
+    }
+
+    // Draw the frame at `offset`, writing only the segments that differ from the frame last drawn
+    void _clipDraw(uint16_t offset)
+    {
+        // Redraw everything on the first frame, or if the bar direction or logic changed
+        const uint8_t state = LANE_DRAWN | (_animRenderDirIsReversed ? LANE_REVERSED : 0) |
+                              (_animRenderLogicIsInverted ? LANE_INVERTED : 0);
+        if (clipState != state)
+        {
+            if (clipState)
+                _barMeter.clear();
+            clipState = state;
+            _clipPrev = 0xFFFF;
+        }
+
+        const uint8_t segs = min(_clip.segsNum, _segsNum);
+        for (uint8_t b = 0; b < (segs + 7) / 8; ++b)
+        {
+            const uint8_t bits = _clip.byteAt(offset + b);
+            const uint8_t diff = (_clipPrev == 0xFFFF) ? 0xFF : bits ^ _clip.byteAt(_clipPrev + b);
+            for (uint8_t k = 0; diff >> k; ++k) // whole byte skipped when unchanged
+            {
+                const uint16_t i = (b << 3) + k;
+                if (i >= segs)
+                    break;
+                if ((diff >> k) & 1)
+                    _barMeter.setPixel(_corrPixelToDir(i), ((bits >> k) & 1) != _animRenderLogicIsInverted);
+            }
+        }
+        _clipPrev = offset;
+    }
+#undef clipState
+#undef clipRepeat
+
+#define scriptLevel _ledTracker1
+#define scriptTarget _ledTracker2
+#define scriptOp _sequenceState
+#define emitLength _param1
+#define emitHead _counter2
+#define holdStart _lastUpdate2
+#define holdTime _updateIntv2
+    bool _runScript()
+    {
+        if (_init)
+        {
+            _init = false;
+            if (!_animLogicSet)
+                _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
+            _scriptPc = 0;
+            _scriptLoopDepth = 0;
+            scriptOp = SBK_SCRIPT_OP_END;
+            scriptLevel = 0;
+            _updateIntv1 = 20;
+            _scriptRedraw();
+            _lastUpdate1 = _currentTime;
+            return false;
+        }
+        if (!_script)
+            return true;
+
+        // Run instant instructions until a timed one is active (bounded per update)
+        for (uint8_t guard = 0; scriptOp == SBK_SCRIPT_OP_END; ++guard)
+        {
+            if (guard >= 16)
+                return false; // resume on next update
+
+            const uint8_t op = _scriptByte(_scriptPc++);
+            switch (op)
+            {
+            case SBK_SCRIPT_OP_END:
+                return true; // script done
+
+            case SBK_SCRIPT_OP_INTV:
+                _updateIntv1 = max((uint16_t)1, _scriptWord(_scriptPc));
+                _scriptPc += 2;
+                break;
+
+            case SBK_SCRIPT_OP_FILL_TO:
+            case SBK_SCRIPT_OP_EMPTY_TO:
+                scriptTarget = _scriptLevelOf(_scriptByte(_scriptPc++));
+                if ((op == SBK_SCRIPT_OP_FILL_TO) ? (scriptLevel < scriptTarget) : (scriptLevel > scriptTarget))
+                    scriptOp = op;
+                break;
+
+            case SBK_SCRIPT_OP_SET_TO:
+                scriptLevel = _scriptLevelOf(_scriptByte(_scriptPc++));
+                _scriptRedraw();
+                break;
+
+            case SBK_SCRIPT_OP_HOLD:
+                holdTime = _scriptWord(_scriptPc);
+                _scriptPc += 2;
+                holdStart = _currentTime;
+                scriptOp = op;
+                break;
+
+            case SBK_SCRIPT_OP_REPEAT:
+                if (_scriptLoopDepth < SBK_SCRIPT_MAX_NESTING)
+                {
+                    _scriptLoopCount[_scriptLoopDepth] = _scriptByte(_scriptPc);
+                    _scriptLoopPc[_scriptLoopDepth] = _scriptPc + 1;
+                }
+                _scriptLoopDepth++;
+                _scriptPc++;
+                break;
+
+            case SBK_SCRIPT_OP_NEXT:
+            {
+                if (!_scriptLoopDepth)
+                    break;
+                const uint8_t d = _scriptLoopDepth - 1;
+                if (d >= SBK_SCRIPT_MAX_NESTING)
+                    _scriptLoopDepth--; // too deep: body runs once
+                else if (_scriptLoopCount[d] == 0 || --_scriptLoopCount[d])
+                    _scriptPc = _scriptLoopPc[d]; // forever, or runs left
+                else
+                    _scriptLoopDepth--;
+                break;
+            }
+
+            case SBK_SCRIPT_OP_EMIT:
+                emitLength = _scriptByte(_scriptPc++);
+                if (!emitLength)
+                    emitLength = 1;
+                emitHead = scriptLevel; // head position + 1
+                scriptOp = op;
+                break;
+
+            case SBK_SCRIPT_OP_INVERT:
+                _animRenderLogicIsInverted = !_animRenderLogicIsInverted;
+                _scriptRedraw();
+                break;
+
+            default:
+                return true; // unknown opcode: stop there
+            }
+        }
+
+        if (scriptOp == SBK_SCRIPT_OP_HOLD)
+        {
+            if (_currentTime - holdStart >= holdTime)
+                scriptOp = SBK_SCRIPT_OP_END;
+            return false;
+        }
+
+        if (_currentTime - _lastUpdate1 >= _updateIntv1)
+        {
+            _lastUpdate1 = _stepTime(_updateIntv1);
+            switch (scriptOp)
+            {
+            case SBK_SCRIPT_OP_FILL_TO:
+                _scriptPixel(scriptLevel++, true);
+                if (scriptLevel >= scriptTarget)
+                    scriptOp = SBK_SCRIPT_OP_END;
+                break;
+
+            case SBK_SCRIPT_OP_EMPTY_TO:
+                _scriptPixel(--scriptLevel, false);
+                if (scriptLevel <= scriptTarget)
+                    scriptOp = SBK_SCRIPT_OP_END;
+                break;
+
+            case SBK_SCRIPT_OP_EMIT:
+            {
+                // Block covers [head - length + 1, head], above the level
+                const int16_t head = emitHead++;
+                const int16_t tail = head - emitLength;
+                if (head < _segsNum)
+                    _scriptPixel(head, true);
+                if (tail >= scriptLevel && tail < _segsNum)
+                    _scriptPixel(tail, false);
+                if (tail >= _segsNum - 1 || emitHead == 0xFF)
+                    scriptOp = SBK_SCRIPT_OP_END;
+                break;
+            }
+            }
+        }
+        return false;
+    }
+
+    inline uint8_t _scriptByte(uint16_t pc) const
+    {
+        return _scriptProgmem ? pgm_read_byte(_script + pc) : _script[pc];
+    }
+    inline uint16_t _scriptWord(uint16_t pc) const
+    {
+        return _scriptByte(pc) | ((uint16_t)_scriptByte(pc + 1) << 8);
+    }
+    inline int8_t _scriptLevelOf(uint8_t percent) const
+    {
+        return (int8_t)(((uint16_t)min(percent, (uint8_t)100) * _segsNum) / 100);
+    }
+    inline void _scriptPixel(uint8_t i, bool on)
+    {
+        _barMeter.setPixel(_corrPixelToDir(i), on != _animRenderLogicIsInverted);
+    }
+    void _scriptRedraw()
+    {
+        for (uint8_t i = 0; i < _segsNum; ++i)
+            _scriptPixel(i, (int16_t)i < scriptLevel);
+    }
+#undef scriptLevel
+#undef scriptTarget
+#undef scriptOp
+#undef emitLength
+#undef emitHead
+#undef holdStart
+#undef holdTime
+
+    template <typename EffectT>
+    bool _runEffect()
+    {
+        if (_init)
+        {
+            if (!_animLogicSet)
+                _animRenderLogicIsInverted = _AnimInitLogicIsInverted;
+            _prevAnimRenderLogic = _animRenderLogicIsInverted;
+            _effectDirReversed = _animRenderDirIsReversed;
+            _lastUpdate1 = _currentTime;
+        }
+        else
+        {
+            // Logic or direction changed mid-cycle: remap what the effect already drew
+            if (_animRenderLogicIsInverted != _prevAnimRenderLogic)
+            {
+                _prevAnimRenderLogic = _animRenderLogicIsInverted;
+                for (uint8_t i = 0; i < _segsNum; ++i)
+                    _barMeter.setPixel(i, !_barMeter.getPixelState(i));
+            }
+            if (_animRenderDirIsReversed != _effectDirReversed)
+            {
+                _effectDirReversed = _animRenderDirIsReversed;
+                for (uint8_t i = 0; i < _segsNum / 2; ++i)
+                {
+                    const uint8_t j = (_segsNum - 1) - i;
+                    const bool a = _barMeter.getPixelState(i);
+                    _barMeter.setPixel(i, _barMeter.getPixelState(j));
+                    _barMeter.setPixel(j, a);
+                }
+            }
+        }
+        EffectContext ctx(*this);
+        const bool done = (*static_cast<EffectT *>(_effect))(ctx);
+        _init = false;
+        return done;
+    }
+
+#ifdef SBK_BARDRIVE_HAS_COROUTINES
+    bool _runCoroutine()
+    {
+        if (_init)
+        {
+            _init = false;
+            _coroTask.reset(); // free the previous frame before allocating the new one
+            if (_coroScript)
+                _coroTask = _coroScript(_barMeter);
+            if (!_coroTask.valid())
+                return true; // no script, or no arena slot
+        }
+        return _coroTask.resume(_currentTime);
+    }
+#endif
 };
@@ -0,0 +1,90 @@
+/**
+ * @file SBK_BarScript.h
+ * @brief Compact bytecode for bar animation choreographies, played by `SBK_BarMeterAnimations::playScript()`.
+ *
+ * A script is a byte array, normally in PROGMEM, of one-byte opcodes followed by their operands.
+ * The `SBK_SCRIPT_*` macros below are the assembler: they expand to the opcode and operand bytes,
+ * so a choreography is written directly as a `const uint8_t PROGMEM` array and costs a few bytes
+ * of flash per step and no RAM growth whatever its length.
+ *
+ * @code
+ * const uint8_t show[] PROGMEM = {
+ *     SBK_SCRIPT_INTV(15),
+ *     SBK_SCRIPT_REPEAT(3),
+ *         SBK_SCRIPT_FILL_TO(100),
+ *         SBK_SCRIPT_HOLD(200),
+ *         SBK_SCRIPT_EMPTY_TO(30),
+ *     SBK_SCRIPT_NEXT,
+ *     SBK_SCRIPT_INTV(40),
+ *     SBK_SCRIPT_EMIT(3),
+ *     SBK_SCRIPT_INVERT,
+ *     SBK_SCRIPT_EMPTY_TO(0),
+ *     SBK_SCRIPT_END};
+ *
+ * bar.animations().animInit().playScript(show).loop();
+ * @endcode
+ *
+ * The script draws a fill level (segments below it are on). Timed operations advance one
+ * segment per interval; `INVERT` swaps on and off segments; loops nest up to
+ * `SBK_SCRIPT_MAX_NESTING` levels.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @def SBK_SCRIPT_MAX_NESTING
+ * @brief Maximum nesting depth of `SBK_SCRIPT_REPEAT` loops. Default is 2.
+ */
+#ifndef SBK_SCRIPT_MAX_NESTING
+#define SBK_SCRIPT_MAX_NESTING 2
+#endif
+
+/**
+ * @enum SBK_BarScriptOp
+ * @brief Script opcodes. Use the `SBK_SCRIPT_*` macros rather than raw values.
+ */
+enum SBK_BarScriptOp : uint8_t
+{
+    SBK_SCRIPT_OP_END = 0x00,      ///< End of script (animation cycle complete).
+    SBK_SCRIPT_OP_INTV = 0x01,     ///< [lo, hi] Set the step interval in milliseconds.
+    SBK_SCRIPT_OP_FILL_TO = 0x02,  ///< [percent] Fill up, one segment per step, to a level.
+    SBK_SCRIPT_OP_EMPTY_TO = 0x03, ///< [percent] Empty down, one segment per step, to a level.
+    SBK_SCRIPT_OP_HOLD = 0x04,     ///< [lo, hi] Hold the current frame for a time in milliseconds.
+    SBK_SCRIPT_OP_REPEAT = 0x05,   ///< [count] Start a loop body run `count` times (0 = forever).
+    SBK_SCRIPT_OP_NEXT = 0x06,     ///< End of the innermost loop body.
+    SBK_SCRIPT_OP_EMIT = 0x07,     ///< [length] Send a block from the level to the top, one segment per step.
+    SBK_SCRIPT_OP_INVERT = 0x08,   ///< Swap on and off segments.
+    SBK_SCRIPT_OP_SET_TO = 0x09    ///< [percent] Jump to a level at once.
+};
+
+/** @brief Assemble an END instruction. */
+#define SBK_SCRIPT_END SBK_SCRIPT_OP_END
+/** @brief Assemble a step interval change, in milliseconds (0–65535). */
+#define SBK_SCRIPT_INTV(ms) SBK_SCRIPT_OP_INTV, (uint8_t)((ms) & 0xFF), (uint8_t)(((ms) >> 8) & 0xFF)
+/** @brief Assemble a fill up to `percent` of the bar. */
+#define SBK_SCRIPT_FILL_TO(percent) SBK_SCRIPT_OP_FILL_TO, (uint8_t)(percent)
+/** @brief Assemble an empty down to `percent` of the bar. */
+#define SBK_SCRIPT_EMPTY_TO(percent) SBK_SCRIPT_OP_EMPTY_TO, (uint8_t)(percent)
+/** @brief Assemble an immediate jump to `percent` of the bar. */
+#define SBK_SCRIPT_SET_TO(percent) SBK_SCRIPT_OP_SET_TO, (uint8_t)(percent)
+/** @brief Assemble a hold, in milliseconds (0–65535). */
+#define SBK_SCRIPT_HOLD(ms) SBK_SCRIPT_OP_HOLD, (uint8_t)((ms) & 0xFF), (uint8_t)(((ms) >> 8) & 0xFF)
+/** @brief Assemble a loop start, body run `count` times (1–255, 0 = forever). */
+#define SBK_SCRIPT_REPEAT(count) SBK_SCRIPT_OP_REPEAT, (uint8_t)(count)
+/** @brief Assemble a loop end. */
+#define SBK_SCRIPT_NEXT SBK_SCRIPT_OP_NEXT
+/** @brief Assemble a block emission of `length` segments. */
+#define SBK_SCRIPT_EMIT(length) SBK_SCRIPT_OP_EMIT, (uint8_t)(length)
+/** @brief Assemble a logic inversion. */
+#define SBK_SCRIPT_INVERT SBK_SCRIPT_OP_INVERT
@@ -0,0 +1,90 @@
+/**
+ * @file SBK_BarTimebase.h
+ * @brief Shared animation clock for phase-locked animations across bars.
+ *
+ * This file defines the `SBK_BarTimebase` class. A timebase is a common time origin that
+ * several `SBK_BarMeterAnimations` can attach to: their steps are aligned on the same time
+ * grid and their closed-form timelines are read from the same clock, so bars started one
+ * after the other stay in sync, or keep a deliberate phase offset, without drifting.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @class SBK_BarTimebase
+ * @brief Common time origin shared by phase-locked animations.
+ *
+ * @code
+ * SBK_BarTimebase wave;
+ *
+ * void setup() {
+ *     for (uint8_t i = 0; i < 10; ++i)
+ *         bars[i].animations().animInit().bounceFillUpIntv(10, 10).loop()
+ *                .attachTimebase(wave, i * 50); // 50 ms phase step between bars
+ *     wave.restart();
+ * }
+ * @endcode
+ */
+class SBK_BarTimebase
+{
+public:
+    /**
+     * @brief Construct a timebase.
+     * @param origin Time origin, in `millis()` units. Default is 0 (board start).
+     */
+    explicit SBK_BarTimebase(uint32_t origin = 0) : _origin(origin) {}
+
+    /**
+     * @brief Move the time origin, restarting every attached animation cycle from its phase offset.
+     * @param now Optional timestamp of the new origin.
+     */
+    void restart(uint32_t now = millis()) { _origin = now; }
+
+    /** @brief Get the time origin, in `millis()` units. */
+    uint32_t origin() const { return _origin; }
+
+    /**
+     * @brief Get the time elapsed since the origin.
+     * @param now Optional timestamp.
+     * @return Elapsed time in milliseconds.
+     */
+    uint32_t elapsed(uint32_t now = millis()) const { return now - _origin; }
+
+    /**
+     * @brief Get the position within a repeating period.
+     * @param period Period in milliseconds.
+     * @param offset Optional phase offset in milliseconds. Default is 0.
+     * @param now    Optional timestamp.
+     * @return Position in the period (0 to `period - 1`), 0 if `period` is 0.
+     */
+    uint32_t phase(uint32_t period, uint32_t offset = 0, uint32_t now = millis()) const
+    {
+        return period ? (elapsed(now) + offset) % period : 0;
+    }
+
+    /**
+     * @brief Get the latest grid instant of a repeating period, at or before `now`.
+     * @param period Period in milliseconds.
+     * @param offset Optional phase offset in milliseconds. Default is 0.
+     * @param now    Optional timestamp.
+     * @return Timestamp of the last period boundary.
+     */
+    uint32_t lastTick(uint32_t period, uint32_t offset = 0, uint32_t now = millis()) const
+    {
+        return now - phase(period, offset, now);
+    }
+
+private:
+    uint32_t _origin;
+};
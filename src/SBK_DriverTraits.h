@@ -0,0 +1,153 @@
+/**
+ * @file SBK_DriverTraits.h
+ * @brief Compile-time detection of optional driver capabilities.
+ *
+ * SBK display drivers share a mandatory API (`setLed()`, `getLed()`, `show()`, `devsNum()`,
+ * `maxRows()`, `maxColumns()`, `maxSegments()`). Some drivers also expose hardware features
+ * the bar layer can offload work to. The helpers in this file detect those optional methods
+ * at compile time and call them when present, or report them as unsupported otherwise,
+ * without any runtime cost or requirement on drivers that lack them.
+ *
+ * @author
+ * Samuel Barabé (Smart Builds & Kits)
+ *
+ * @version 2.0.4
+ * @license MIT
+ *
+ * @copyright
+ * Copyright (c) 2025 Samuel Barabé
+ */
+
+#pragma once
+
+#include <Arduino.h>
+
+/**
+ * @struct SBK_DriverHasBlink
+ * @brief Detects a hardware blink method `setBlinkRate(uint8_t devIdx, uint8_t rate)`.
+ *
+ * Rate follows the HT16K33 blink register: 0 = off, 1 = 2 Hz, 2 = 1 Hz, 3 = 0.5 Hz.
+ */
+template <typename DriverT>
+struct SBK_DriverHasBlink
+{
+    template <typename U>
+    static char test(decltype(((U *)0)->setBlinkRate((uint8_t)0, (uint8_t)0), 0) *);
+    template <typename U>
+    static long test(...);
+    static const bool value = sizeof(test<DriverT>(0)) == sizeof(char);
+};
+
+/**
+ * @struct SBK_DriverBlink
+ * @brief Calls the driver hardware blink when available.
+ */
+template <typename DriverT, bool = SBK_DriverHasBlink<DriverT>::value>
+struct SBK_DriverBlink
+{
+    static const bool supported = false;
+    /** @brief No hardware blink: does nothing and returns false. */
+    static bool set(DriverT *, uint8_t, uint8_t) { return false; }
+};
+
+template <typename DriverT>
+struct SBK_DriverBlink<DriverT, true>
+{
+    static const bool supported = true;
+    /** @brief Set the device blink rate (0 = off, 1 = 2 Hz, 2 = 1 Hz, 3 = 0.5 Hz). */
+    static bool set(DriverT *driver, uint8_t devIdx, uint8_t rate)
+    {
+        return _call(driver, devIdx, rate, (decltype(driver->setBlinkRate(devIdx, rate)) *)0);
+    }
+
+private:
+    // A driver method returning bool reports whether the request was honored; void means it was.
+    static bool _call(DriverT *driver, uint8_t devIdx, uint8_t rate, void *)
+    {
+        driver->setBlinkRate(devIdx, rate);
+        return true;
+    }
+    static bool _call(DriverT *driver, uint8_t devIdx, uint8_t rate, bool *) { return driver->setBlinkRate(devIdx, rate); }
+};
+
+/**
+ * @struct SBK_DriverHasShutdown
+ * @brief Detects a power-down method `shutdown(uint8_t devIdx, bool status)`.
+ *
+ * `status` true puts the device in its shutdown / standby mode (display off, scan stopped,
+ * buffer kept), false resumes normal operation.
+ */
+template <typename DriverT>
+struct SBK_DriverHasShutdown
+{
+    template <typename U>
+    static char test(decltype(((U *)0)->shutdown((uint8_t)0, false), 0) *);
+    template <typename U>
+    static long test(...);
+    static const bool value = sizeof(test<DriverT>(0)) == sizeof(char);
+};
+
+/**
+ * @struct SBK_DriverPower
+ * @brief Calls the driver power-down when available.
+ */
+template <typename DriverT, bool = SBK_DriverHasShutdown<DriverT>::value>
+struct SBK_DriverPower
+{
+    static const bool supported = false;
+    /** @brief No power-down mode: does nothing and returns false. */
+    static bool set(DriverT *, uint8_t, bool) { return false; }
+};
+
+template <typename DriverT>
+struct SBK_DriverPower<DriverT, true>
+{
+    static const bool supported = true;
+    /** @brief Put the device in shutdown mode (true) or wake it up (false). */
+    static bool set(DriverT *driver, uint8_t devIdx, bool down)
+    {
+        return _call(driver, devIdx, down, (decltype(driver->shutdown(devIdx, down)) *)0);
+    }
+
+private:
+    static bool _call(DriverT *driver, uint8_t devIdx, bool down, void *)
+    {
+        driver->shutdown(devIdx, down);
+        return true;
+    }
+    static bool _call(DriverT *driver, uint8_t devIdx, bool down, bool *) { return driver->shutdown(devIdx, down); }
+};
+
+/**
+ * @struct SBK_DriverHasGetBrightness
+ * @brief Detects a brightness getter `getBrightness(uint8_t devIdx)`.
+ */
+template <typename DriverT>
+struct SBK_DriverHasGetBrightness
+{
+    template <typename U>
+    static char test(decltype(((const U *)0)->getBrightness((uint8_t)0), 0) *);
+    template <typename U>
+    static long test(...);
+    static const bool value = sizeof(test<DriverT>(0)) == sizeof(char);
+};
+
+/**
+ * @struct SBK_DriverBrightness
+ * @brief Reads the device brightness when the driver can report it.
+ */
+template <typename DriverT, bool = SBK_DriverHasGetBrightness<DriverT>::value>
+struct SBK_DriverBrightness
+{
+    static const bool supported = false;
+    /** @brief No brightness getter: returns `fallback`. */
+    static uint8_t get(const DriverT *, uint8_t, uint8_t fallback) { return fallback; }
+};
+
+template <typename DriverT>
+struct SBK_DriverBrightness<DriverT, true>
+{
+    static const bool supported = true;
+    /** @brief Get the device brightness level. */
+    static uint8_t get(const DriverT *driver, uint8_t devIdx, uint8_t) { return driver->getBrightness(devIdx); }
+};